@@ -16,6 +16,7 @@
 #include "hardware/gpio.h"
 #include "hardware/pwm.h"
 #include "stdio.h"
+#include "string.h"
 #include "hardware/sync.h" // Necessário para irq_set_enabled
 #include "hardware/irq.h"  // Necessário para IO_IRQ_GPIO_GROUP0
 #include "pico/bootrom.h"  // Para reset_usb_boot
@@ -27,8 +28,11 @@
 
 // Libs customizadas
 #include "lib/display_init.h" // Contém extern ssd, display(), etc.
+#include "lib/display_task.h" // Tarefa dona do display (fila de mensagens)
 #include "lib/font.h"         // Necessário para a fonte 
 #include "lib/buzzer.h"      // Funções para controle do buzzer
+#include "lib/matrixws.h"    // Matriz de LEDs WS2812 5x5
+#include "lib/matrixws_anim.h" // Animações da matriz sem bloquear as tarefas
 
 
 // --- Definições de Hardware (Pinos) --- //
@@ -42,6 +46,12 @@
 #define LED_G_GPIO    11      // PWM verde
 #define LED_B_GPIO    12      // PWM azul
 
+// --- Animações da Matriz de LEDs --- //
+#define MATRIZ_TRANSICAO_MS 300 // Transição entre dois níveis de ocupação
+#define LOTADO_PISCADAS     3   // Piscadas quando a entrada é recusada
+#define LOTADO_FADE_MS      120
+#define LOTADO_PAUSA_MS     80
+
 // --- Configuração do Display OLED --- //
 #define I2C_PORT      i2c1
 #define I2C_SDA_PIN   14
@@ -50,13 +60,18 @@
 #define OLED_WIDTH    128
 #define OLED_HEIGHT   64
 
+// --- Pilha das Tarefas de Evento (Entrada, Saída, Reset), em palavras --- //
+#define PILHA_EVENTOS 256 // Não medida na placa: confira g_eventos_pilha_livre
+
 // --- Variáveis Globais e Handles do FreeRTOS --- //
-SemaphoreHandle_t xDisplayMutex;   // Mutex para proteger o acesso ao display
 SemaphoreHandle_t xUsuariosSem;    // Semáforo de contagem para usuários ativos
 SemaphoreHandle_t xResetSem;       // Semáforo binário para o evento de reset
 SemaphoreHandle_t xEntradaSem;     // Semáforo binário para evento de entrada
 SemaphoreHandle_t xSaidaSem;       // Semáforo binário para evento de saída
 
+// Mínimo de pilha livre (palavras) entre as tarefas de evento
+volatile uint32_t g_eventos_pilha_livre = PILHA_EVENTOS;
+
 // Variável para a contagem de usuários ativos
 volatile uint8_t g_num_usuarios_ativos = 0;
 // Variável para a capacidade máxima de usuários
@@ -76,6 +91,19 @@ void vTaskReset(void *pvParameters);    // Tarefa de reset
 // --- Funções de Feedback (Auxiliares) ---
 void atualizar_feedback_display(void);
 void atualizar_feedback_led_rgb(void);
+void atualizar_feedback_matriz(void);
+
+// Alerta de capacidade máxima: pisca e termina no quadro de lotação
+static matriz_quadro_t quadros_lotado[2 * LOTADO_PISCADAS];
+static const matriz_anim_t anim_lotado = { quadros_lotado, 2 * LOTADO_PISCADAS, false };
+
+// Chamada pelas tarefas de evento ao fim de cada evento
+static void registrar_pilha(void) {
+    uint32_t livre = uxTaskGetStackHighWaterMark(NULL);
+    if (livre < g_eventos_pilha_livre) {
+        g_eventos_pilha_livre = livre;
+    }
+}
 
 // --- ÚNICA FUNÇÃO DE CALLBACK DE INTERRUPÇÃO GLOBAL (gpio_irq_handler) ---
 void gpio_irq_handler(uint gpio, uint32_t events) {
@@ -130,38 +158,55 @@ void set_rgb_color(uint8_t r, uint8_t g, uint8_t b) {
 }
 
 // --- Funções de Feedback (Auxiliares) ---
-// Função para atualizar o display OLED
+// Função para atualizar o display OLED: só envia o novo estado para a tarefa
+// do display, que desenha e envia no próximo quadro
 void atualizar_feedback_display(void) {
-    char buffer[32];
-    if (xSemaphoreTake(xDisplayMutex, portMAX_DELAY) == pdTRUE) {
-        ssd1306_fill(&ssd, false);
-
-        snprintf(buffer, sizeof(buffer), "Users: %d/%d", g_num_usuarios_ativos, MAX_USUARIOS);
-        ssd1306_draw_string(&ssd, buffer, 0, 0);
-
-        if (g_num_usuarios_ativos == 0) {
-            ssd1306_draw_string(&ssd, "STATUS: VACANT", 0, 20);
-        } else if (g_num_usuarios_ativos < MAX_USUARIOS) {
-            ssd1306_draw_string(&ssd, "STATUS: OK", 0, 20);
-        } else {
-            ssd1306_draw_string(&ssd, "STATUS: FULL!!!", 0, 20);
-        }
+    display_task_ocupacao(g_num_usuarios_ativos, MAX_USUARIOS);
+}
 
-        ssd1306_send_data(&ssd);
-        xSemaphoreGive(xDisplayMutex);
+// Cor do estado de ocupação, usada pelo LED RGB e pela matriz
+static void cor_ocupacao(uint8_t usuarios, uint8_t cor[3]) {
+    cor[0] = cor[1] = cor[2] = 0;
+    if (usuarios == 0) {
+        cor[2] = 255; // Azul - Nenhum usuário logado
+    } else if (usuarios > 0 && usuarios <= (MAX_USUARIOS - 2)) {
+        cor[1] = 255; // Verde - Usuários ativos (de 0 a MAX-2)
+    } else if (usuarios == (MAX_USUARIOS - 1)) {
+        cor[0] = cor[1] = 255; // Amarelo - Apenas 1 vaga restante
+    } else { // usuarios == MAX_USUARIOS
+        cor[0] = 255; // Vermelho - Capacidade máxima
     }
 }
 
 // Função para atualizar o LED RGB
 void atualizar_feedback_led_rgb(void) {
-    if (g_num_usuarios_ativos == 0) {
-        set_rgb_color(0, 0, 255); // Azul - Nenhum usuário logado
-    } else if (g_num_usuarios_ativos > 0 && g_num_usuarios_ativos <= (MAX_USUARIOS - 2)) {
-        set_rgb_color(0, 255, 0); // Verde - Usuários ativos (de 0 a MAX-2)
-    } else if (g_num_usuarios_ativos == (MAX_USUARIOS - 1)) {
-        set_rgb_color(255, 255, 0); // Amarelo - Apenas 1 vaga restante
-    } else { // g_num_usuarios_ativos == MAX_USUARIOS
-        set_rgb_color(255, 0, 0); // Vermelho - Capacidade máxima
+    uint8_t cor[3];
+    cor_ocupacao(g_num_usuarios_ativos, cor);
+    set_rgb_color(cor[0], cor[1], cor[2]);
+}
+
+// Função para atualizar a matriz: acende a fração ocupada dos LEDs, na cor
+// do LED RGB. Só envia o quadro de destino; a transição é da tarefa da matriz.
+void atualizar_feedback_matriz(void) {
+    matriz_quadro_t q = { .transicao_ms = MATRIZ_TRANSICAO_MS };
+    uint8_t cor[3];
+    cor_ocupacao(g_num_usuarios_ativos, cor);
+    uint acesos = (g_num_usuarios_ativos * NUM_LEDS + MAX_USUARIOS - 1) / MAX_USUARIOS;
+    for (uint i = 0; i < acesos && i < NUM_LEDS; i++) {
+        memcpy(q.rgb[i], cor, 3);
+    }
+    matriz_anim_transicao(&q);
+}
+
+// Monta o alerta de lotação: apaga e acende toda a matriz em vermelho
+static void preparar_animacoes(void) {
+    for (uint i = 0; i < 2 * LOTADO_PISCADAS; i++) {
+        matriz_quadro_t *q = &quadros_lotado[i];
+        for (uint j = 0; j < NUM_LEDS; j++) {
+            q->rgb[j][0] = (i % 2) ? 255 : 0;
+        }
+        q->transicao_ms = LOTADO_FADE_MS;
+        q->pausa_ms = LOTADO_PAUSA_MS;
     }
 }
 
@@ -172,6 +217,7 @@ void atualizar_feedback_led_rgb(void) {
 void vTaskEntrada(void *pvParameters) {
     (void) pvParameters;
     uint8_t prev_num_usuarios_for_beep = 0; // Para beep de "cheio"
+    bool recusado;
 
     for (;;) {
         // Espera pelo semáforo binário de entrada, sinalizado pela ISR
@@ -183,7 +229,8 @@ void vTaskEntrada(void *pvParameters) {
             g_num_usuarios_ativos = (uint8_t)uxSemaphoreGetCount(xUsuariosSem); // Atualiza global para feedback
 
             // Lógica de feedback: Aviso e beep se o limite for atingido
-            if (result == pdFAIL && g_num_usuarios_ativos == MAX_USUARIOS) {
+            recusado = (result == pdFAIL && g_num_usuarios_ativos == MAX_USUARIOS);
+            if (recusado) {
                 // Se a tentativa de entrada falhou porque o semáforo estava cheio (result == pdFAIL)
                 // e a contagem de usuários já é o máximo, emite o beep de sistema cheio.
                 buzzer_set_freq(BUZZER_GPIO, 500); // Tom de aviso
@@ -194,6 +241,13 @@ void vTaskEntrada(void *pvParameters) {
             // Atualiza o feedback visual e de display após a ação de entrada
             atualizar_feedback_led_rgb();
             atualizar_feedback_display();
+            // O alerta vem por último: substitui a transição (já estava lotado)
+            if (recusado) {
+                matriz_anim_tocar(&anim_lotado);
+            } else {
+                atualizar_feedback_matriz();
+            }
+            registrar_pilha();
         }
     }
 }
@@ -214,6 +268,8 @@ void vTaskSaida(void *pvParameters) {
             // Atualiza o feedback visual e de display após a ação de saída
             atualizar_feedback_led_rgb();
             atualizar_feedback_display();
+            atualizar_feedback_matriz();
+            registrar_pilha();
         }
     }
 }
@@ -246,6 +302,8 @@ void vTaskReset(void *pvParameters) {
             // Atualiza o feedback visual e de display após o reset
             atualizar_feedback_led_rgb();
             atualizar_feedback_display();
+            atualizar_feedback_matriz();
+            registrar_pilha();
 
             // Pequeno delay para evitar resets múltiplos muito rápidos
             vTaskDelay(pdMS_TO_TICKS(500));
@@ -288,12 +346,17 @@ int main() {
     gpio_pull_up(I2C_SDA_PIN);
     gpio_pull_up(I2C_SCL_PIN);
 
-    // Inicializa o display OLED global
+    // Inicializa o display OLED global; um painel sem memória para o
+    // framebuffer fica de fora e o resto do sistema segue sem ele
     display();
 
     // Inicializa os LEDs RGB
     init_rgb_leds();
 
+    // Inicializa a matriz de LEDs (envio por DMA, sem bloquear)
+    controle(PINO_MATRIZ);
+    preparar_animacoes();
+
     // Inicializa o Buzzer
     buzzer_init(BUZZER_GPIO, 1000);
     buzzer_stop(BUZZER_GPIO);
@@ -303,18 +366,20 @@ int main() {
     xResetSem = xSemaphoreCreateBinary(); // Semáforo binário para sinalizar reset
     xEntradaSem = xSemaphoreCreateBinary(); // Semáforo binário para evento de entrada
     xSaidaSem = xSemaphoreCreateBinary();   // Semáforo binário para evento de saída
-    xDisplayMutex = xSemaphoreCreateMutex(); // Mutex para proteger o display
 
     // --- Criação de Tarefas FreeRTOS --- //
-    xTaskCreate(vTaskEntrada, "Entrada", configMINIMAL_STACK_SIZE + 256, NULL, 3, NULL);  // Tarefa de entrada
-    xTaskCreate(vTaskSaida, "Saida", configMINIMAL_STACK_SIZE + 256, NULL, 3, NULL);      // Tarefa de saída
-    xTaskCreate(vTaskReset, "Reset", configMINIMAL_STACK_SIZE + 256, NULL, 4, NULL);      // Tarefa de reset (maior prioridade para reset rápido)
+    xTaskCreate(vTaskEntrada, "Entrada", PILHA_EVENTOS, NULL, 3, NULL);  // Tarefa de entrada
+    xTaskCreate(vTaskSaida, "Saida", PILHA_EVENTOS, NULL, 3, NULL);      // Tarefa de saída
+    xTaskCreate(vTaskReset, "Reset", PILHA_EVENTOS, NULL, 4, NULL);      // Tarefa de reset (maior prioridade para reset rápido)
+    display_task_iniciar(2);                                                              // Tarefa do display (abaixo dos eventos)
+    matriz_anim_iniciar(1);                                                               // Tarefa das animações da matriz (abaixo de todas)
    
 
     // Garante que o feedback inicial esteja correto (todos vagos)
     g_num_usuarios_ativos = (uint8_t)uxSemaphoreGetCount(xUsuariosSem); // Deverá ser 0
     atualizar_feedback_led_rgb();
     atualizar_feedback_display();
+    atualizar_feedback_matriz();
 
 
     // --- Inicia o Escalador FreeRTOS --- //
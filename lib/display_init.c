@@ -5,26 +5,75 @@
 ssd1306_t ssd;
 int borda_estado = 0;
 
+static const display_painel_cfg_t painel_cfg[DISPLAY_PAINEIS] = {
+    { I2C_PORT, I2C_SDA, I2C_SCL, ENDERECO },
+#if DISPLAY_PAINEIS > 1
+    { I2C2_PORT, I2C2_SDA, I2C2_SCL, ENDERECO2 },
+#endif
+};
+
+#if DISPLAY_PAINEIS > 1
+static ssd1306_t paineis_extra[DISPLAY_PAINEIS - 1];
+#endif
+ssd1306_t *paineis[DISPLAY_PAINEIS];
+
+// O primeiro painel é o ssd global, usado também fora da tarefa do display
+static ssd1306_t *painel_obj(uint8_t i) {
+#if DISPLAY_PAINEIS > 1
+    if (i > 0) {
+        return &paineis_extra[i - 1];
+    }
+#else
+    (void) i;
+#endif
+    return &ssd;
+}
+
 // Square center positions
 int centro_y = (WIDTH - square_size) / 2;
 int centro_x = (HEIGHT - square_size) / 2;
 
-void display() {
-    // Initialize I2C
-    i2c_init(I2C_PORT, 400 * 1000);
-    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
-    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C_SDA);
-    gpio_pull_up(I2C_SCL);
-
-    // Initialize display
-    ssd1306_init(&ssd, WIDTH, HEIGHT, true, ENDERECO, I2C_PORT);
-    ssd1306_config(&ssd);
-    ssd1306_fill(&ssd, false);
-    ssd1306_send_data(&ssd);
+// Um painel ausente não trava a inicialização: o primeiro NACK o deixa
+// offline e a tarefa do display tenta recuperá-lo periodicamente. Um painel
+// sem memória para o framebuffer fica NULL em paineis[] e não é usado.
+// Retorna quantos painéis têm framebuffer.
+uint8_t display() {
+    uint8_t controladores = 0;
+    uint8_t prontos = 0;
+    for (uint8_t i = 0; i < DISPLAY_PAINEIS; i++) {
+        const display_painel_cfg_t *cfg = &painel_cfg[i];
+        ssd1306_t *painel = painel_obj(i);
+        paineis[i] = NULL;
+
+        // Initialize I2C (uma vez por controlador)
+        uint8_t bit = 1 << i2c_hw_index(cfg->i2c);
+        if (!(controladores & bit)) {
+            controladores |= bit;
+            i2c_init(cfg->i2c, 400 * 1000);
+            gpio_set_function(cfg->sda, GPIO_FUNC_I2C);
+            gpio_set_function(cfg->scl, GPIO_FUNC_I2C);
+            gpio_pull_up(cfg->sda);
+            gpio_pull_up(cfg->scl);
+        }
+
+        // Initialize display
+        if (!ssd1306_init(painel, WIDTH, HEIGHT, true, cfg->endereco, cfg->i2c)) {
+            continue;
+        }
+        ssd1306_set_bus_pins(painel, cfg->sda, cfg->scl);
+        ssd1306_config(painel);
+        ssd1306_fill(painel, false);
+        ssd1306_send_data(painel);
+        paineis[i] = painel;
+        prontos++;
+    }
+    return prontos;
 }
 
 void desenhar_borda() {
+    if (!ssd.ram_buffer) {
+        return;
+    }
     switch (borda_estado) {
         case 1:
             ssd1306_rect(&ssd, 3, 3, 122, 60, true, false);
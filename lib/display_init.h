@@ -14,6 +14,29 @@ extern ssd1306_t ssd;
 #define I2C_SCL 15
 #define ENDERECO 0x3C
 
+// Painéis: o primeiro é sempre o ssd acima; os demais são descritos em
+// display_init.c e podem estar em outro controlador I2C e/ou endereço.
+// Painéis em controladores diferentes são atualizados em paralelo.
+#ifndef DISPLAY_PAINEIS
+#define DISPLAY_PAINEIS 1
+#endif
+
+// Segundo painel (opcional, DISPLAY_PAINEIS=2), do outro lado da porta, no
+// conector I2C0
+#define I2C2_PORT i2c0
+#define I2C2_SDA 0
+#define I2C2_SCL 1
+#define ENDERECO2 0x3C
+
+typedef struct {
+    i2c_inst_t *i2c;
+    uint8_t sda, scl;
+    uint8_t endereco;
+} display_painel_cfg_t;
+
+// NULL para um painel que ficou sem framebuffer (ver display())
+extern ssd1306_t *paineis[DISPLAY_PAINEIS];
+
 // Square configuration
 #define square_size 8
 extern int centro_y;
@@ -22,7 +45,7 @@ extern int centro_x;
 extern int borda_estado;
 
 // Display functions
-void display();
+uint8_t display();
 void desenhar_borda();
 
 #endif // DISPLAY_H
\ No newline at end of file
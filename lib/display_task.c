@@ -0,0 +1,305 @@
+#include "lib/display_task.h"
+#include "lib/ssd1306_dma.h"
+#include "lib/ssd1306_text.h"
+#include "lib/ssd1306_widgets.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+// A tarefa do display é a única dona dos painéis: as demais tarefas apenas
+// enviam mensagens pela fila, sem mutex. Rajadas de mensagens recebidas
+// dentro de um intervalo de quadro viram um único desenho e envio.
+// Cada painel tem os seus widgets e o seu canal DMA; o envio de um painel
+// começa logo depois do desenho dele, então painéis em controladores I2C
+// diferentes transmitem ao mesmo tempo e um segundo painel quase não soma
+// latência ao quadro.
+
+volatile uint32_t g_display_mensagens = 0;
+volatile uint32_t g_display_quadros = 0;
+volatile uint32_t g_display_desenho_us = 0;
+volatile uint32_t g_display_pilha_livre = 0;
+
+static QueueHandle_t fila_display;
+// Um por controlador I2C: tomado antes de usar o barramento e dado ao fim
+// de cada envio por DMA, que pode ser de qualquer painel do controlador
+static SemaphoreHandle_t flush_sem[2];
+static TickType_t proxima_amostra;
+
+// Tela de status: "Usuários: N/M", a linha de status, uma barra de ocupação,
+// o histórico da ocupação e um aviso rolante na última página.
+// Cada mensagem só atualiza os valores dos widgets; apenas os que mudaram
+// são redesenhados.
+enum {
+    W_TITULO,
+    W_USUARIOS,
+    W_BARRA,
+    W_CAPACIDADE,
+    W_STATUS,
+    W_OCUPACAO,
+    W_HISTORICO,
+    W_AVISO,
+    W_TOTAL
+};
+
+// Título e linha de status na fonte proporcional (texto em UTF-8); os
+// números começam logo após a largura do título (67 colunas); com a
+// capacidade em três dígitos a linha ocupa 127 das 128 colunas
+#define TITULO        "Usuários: "
+#define STATUS_VAGO   "STATUS: VAGO"
+#define STATUS_OK     "STATUS: OK"
+#define STATUS_LOTADO "STATUS: LOTAÇÃO"
+
+// O aviso curto cabe na tela e gira pelo próprio painel; o longo avança
+// uma coluna por vez, no mesmo ritmo
+#define AVISO_NENHUM  ""
+#define AVISO_ULTIMA  "Última vaga disponível"
+#define AVISO_LOTADO  "Capacidade máxima atingida: aguarde a saída de um usuário"
+
+typedef struct {
+    ssd1306_t *ssd;
+    ssd1306_dma_t dma;
+    bool dma_ok;
+    SemaphoreHandle_t sem; // flush_sem do controlador do painel
+    ssd1306_widget_t widgets[W_TOTAL];
+    uint8_t historico[128]; // Uma amostra por coluna do gráfico
+    uint32_t ticker_ms;     // Quando chamar ssd1306_widget_scroll() de novo (0: não precisa)
+    TickType_t ultima_recuperacao;
+} painel_t;
+
+static painel_t telas[DISPLAY_PAINEIS];
+static uint8_t num_telas; // Painéis com framebuffer, em ordem
+static uint8_t usuarios = 0;
+static uint8_t capacidade = 0;
+
+// Fim do envio por DMA (contexto de interrupção do I2C)
+static void flush_concluido(ssd1306_dma_t *dma, bool ok, void *arg) {
+    (void) dma;
+    (void) ok;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR((SemaphoreHandle_t) arg, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+// O número de usuários fica em dígitos 2x para ser lido de longe; o título
+// e "/M" ficam na segunda página, alinhados à base dele
+static void criar_widgets(painel_t *p) {
+    ssd1306_widget_t *widgets = p->widgets;
+    uint8_t x = ssd1306_font_width(&ssd1306_font_prop, TITULO);
+    ssd1306_widget_label(&widgets[W_TITULO], 0, 8, x, TITULO);
+    ssd1306_widget_set_font(&widgets[W_TITULO], &ssd1306_font_prop);
+    ssd1306_widget_number(&widgets[W_USUARIOS], x, 0, 2 * SSD1306_CHAR_W, usuarios, 0);
+    ssd1306_widget_set_scale(&widgets[W_USUARIOS], 2);
+    ssd1306_widget_label(&widgets[W_BARRA], x + 2 * SSD1306_CHAR_W, 8, SSD1306_CHAR_W, "/");
+    ssd1306_widget_number(&widgets[W_CAPACIDADE], x + 3 * SSD1306_CHAR_W, 8, SSD1306_CHAR_W, capacidade, 0);
+    ssd1306_widget_label(&widgets[W_STATUS], 0, 20, p->ssd->width, STATUS_VAGO);
+    ssd1306_widget_set_font(&widgets[W_STATUS], &ssd1306_font_prop);
+    ssd1306_widget_bar(&widgets[W_OCUPACAO], 4, 32, p->ssd->width - 8, 8, usuarios, capacidade);
+    ssd1306_widget_graph(&widgets[W_HISTORICO], 0, 40, p->ssd->width, 16, p->historico, sizeof(p->historico), capacidade);
+    ssd1306_widget_ticker(&widgets[W_AVISO], 0, 56, p->ssd->width, AVISO_NENHUM, SSD1306_SCROLL_5_FRAMES);
+}
+
+// Os campos numéricos têm a largura dos dígitos da capacidade; só muda o
+// layout quando a capacidade muda de número de dígitos
+static void posicionar(painel_t *p) {
+    ssd1306_widget_t *widgets = p->widgets;
+    uint8_t digitos = 1;
+    for (uint8_t c = capacidade; c >= 10; c /= 10) {
+        digitos++;
+    }
+    uint8_t w = digitos * SSD1306_CHAR_W;
+    uint8_t titulo = ssd1306_font_width(&ssd1306_font_prop, TITULO);
+    uint8_t x = titulo + 2 * w;
+    ssd1306_widget_place(p->ssd, &widgets[W_USUARIOS], titulo, 0, 2 * w);
+    ssd1306_widget_place(p->ssd, &widgets[W_BARRA], x, 8, SSD1306_CHAR_W);
+    ssd1306_widget_place(p->ssd, &widgets[W_CAPACIDADE], x + SSD1306_CHAR_W, 8, w);
+}
+
+static void aplicar(const display_msg_t *msg) {
+    g_display_mensagens++;
+    switch (msg->tipo) {
+        case DISPLAY_MSG_OCUPACAO:
+            usuarios = msg->a;
+            if (capacidade != msg->b) {
+                capacidade = msg->b;
+                for (uint8_t i = 0; i < num_telas; i++) {
+                    posicionar(&telas[i]);
+                }
+            }
+            break;
+        case DISPLAY_MSG_REDESENHAR:
+            for (uint8_t i = 0; i < num_telas; i++) {
+                ssd1306_force_redraw(telas[i].ssd);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void desenhar(painel_t *p) {
+    ssd1306_widget_t *widgets = p->widgets;
+    ssd1306_widget_set_value(&widgets[W_USUARIOS], usuarios);
+    ssd1306_widget_set_value(&widgets[W_CAPACIDADE], capacidade);
+    ssd1306_widget_set_value(&widgets[W_OCUPACAO], usuarios);
+    ssd1306_widget_set_max(&widgets[W_OCUPACAO], capacidade);
+    ssd1306_widget_set_max(&widgets[W_HISTORICO], capacidade);
+
+    if (usuarios == 0) {
+        ssd1306_widget_set_text(&widgets[W_STATUS], STATUS_VAGO);
+    } else if (usuarios < capacidade) {
+        ssd1306_widget_set_text(&widgets[W_STATUS], STATUS_OK);
+    } else {
+        ssd1306_widget_set_text(&widgets[W_STATUS], STATUS_LOTADO);
+    }
+
+    if (capacidade > 0 && usuarios >= capacidade) {
+        ssd1306_widget_set_text(&widgets[W_AVISO], AVISO_LOTADO);
+    } else if (capacidade > 1 && usuarios == capacidade - 1) {
+        ssd1306_widget_set_text(&widgets[W_AVISO], AVISO_ULTIMA);
+    } else {
+        ssd1306_widget_set_text(&widgets[W_AVISO], AVISO_NENHUM);
+    }
+
+    ssd1306_widgets_draw(p->ssd, widgets, W_TOTAL);
+}
+
+// Com o display offline (NACK ou prazo estourado) a própria tarefa tenta
+// recuperá-lo, no máximo uma vez a cada DISPLAY_RECUPERACAO_MS; as tarefas
+// de evento nunca esperam pelo barramento
+static bool recuperar(painel_t *p) {
+    TickType_t agora = xTaskGetTickCount();
+    if (agora - p->ultima_recuperacao < pdMS_TO_TICKS(DISPLAY_RECUPERACAO_MS)) {
+        return false;
+    }
+    p->ultima_recuperacao = agora;
+    return ssd1306_recover(p->ssd);
+}
+
+// Cancela o envio travado do controlador, seja de qual painel for
+static void abortar_envios(SemaphoreHandle_t sem) {
+    for (uint8_t i = 0; i < num_telas; i++) {
+        if (telas[i].sem == sem && telas[i].dma_ok) {
+            ssd1306_flush_abort(&telas[i].dma);
+        }
+    }
+}
+
+static void enviar(painel_t *p) {
+    // O quadro é copiado para o buffer do DMA no início do envio, então a
+    // tarefa só espera aqui se o envio anterior no mesmo controlador ainda
+    // não terminou; um envio que passa do prazo é cancelado e conta como falha
+    if (xSemaphoreTake(p->sem, pdMS_TO_TICKS(DISPLAY_ENVIO_MAX_MS)) != pdTRUE) {
+        abortar_envios(p->sem);
+    }
+
+    p->ticker_ms = 0;
+    if (p->ssd->online || recuperar(p)) {
+        // Com o barramento livre: comandos de rolagem antes dos dados do quadro
+        p->ticker_ms = ssd1306_widget_scroll(p->ssd, &p->widgets[W_AVISO], xTaskGetTickCount() * portTICK_PERIOD_MS);
+        if (!p->dma_ok) {
+            ssd1306_send_dirty(p->ssd);
+        } else if (ssd1306_flush_async(&p->dma, flush_concluido, p->sem)) {
+            return; // flush_concluido devolve o semáforo
+        }
+    }
+    xSemaphoreGive(p->sem); // Nada foi enviado por DMA
+}
+
+static void vTaskDisplay(void *pvParameters) {
+    (void) pvParameters;
+    const TickType_t intervalo = pdMS_TO_TICKS(DISPLAY_QUADRO_MS);
+    TickType_t ultimo_quadro = xTaskGetTickCount() - intervalo;
+    for (uint8_t i = 0; i < num_telas; i++) {
+        telas[i].ultima_recuperacao = xTaskGetTickCount() - pdMS_TO_TICKS(DISPLAY_RECUPERACAO_MS);
+    }
+    proxima_amostra = xTaskGetTickCount();
+    display_msg_t msg;
+
+    for (;;) {
+        // A tarefa acorda sozinha offline, para tentar a recuperação, com o
+        // aviso rolando, no prazo do próximo passo (ou para religar a rolagem
+        // do painel), e na hora da próxima amostra do histórico
+        TickType_t ocioso = portMAX_DELAY;
+        for (uint8_t i = 0; i < num_telas; i++) {
+            TickType_t t = portMAX_DELAY;
+            if (telas[i].ticker_ms) {
+                t = pdMS_TO_TICKS(telas[i].ticker_ms);
+            } else if (!telas[i].ssd->online) {
+                t = pdMS_TO_TICKS(DISPLAY_RECUPERACAO_MS);
+            }
+            if (t < ocioso) {
+                ocioso = t;
+            }
+        }
+        TickType_t ate_amostra = proxima_amostra - xTaskGetTickCount();
+        if ((int32_t) ate_amostra <= 0) {
+            ate_amostra = 0;
+        }
+        if (ate_amostra < ocioso) {
+            ocioso = ate_amostra;
+        }
+        if (xQueueReceive(fila_display, &msg, ocioso) == pdTRUE) {
+            aplicar(&msg);
+
+            // Agrupa o que chegar até o próximo horário de quadro
+            for (;;) {
+                TickType_t decorrido = xTaskGetTickCount() - ultimo_quadro;
+                TickType_t espera = decorrido < intervalo ? intervalo - decorrido : 0;
+                if (xQueueReceive(fila_display, &msg, espera) != pdTRUE) {
+                    break;
+                }
+                aplicar(&msg);
+            }
+        }
+
+        // O gráfico só anda uma coluna por amostra; o envio cobre só a área dele
+        if ((int32_t) (xTaskGetTickCount() - proxima_amostra) >= 0) {
+            for (uint8_t i = 0; i < num_telas; i++) {
+                ssd1306_widget_push(&telas[i].widgets[W_HISTORICO], usuarios);
+            }
+            proxima_amostra += pdMS_TO_TICKS(DISPLAY_HISTORICO_MS);
+        }
+
+        uint32_t desenho_us = 0;
+        for (uint8_t i = 0; i < num_telas; i++) {
+            uint32_t inicio = time_us_32();
+            desenhar(&telas[i]);
+            desenho_us += time_us_32() - inicio;
+            enviar(&telas[i]);
+        }
+        g_display_desenho_us = desenho_us;
+        g_display_pilha_livre = uxTaskGetStackHighWaterMark(NULL);
+        ultimo_quadro = xTaskGetTickCount();
+        g_display_quadros++;
+    }
+}
+
+// Deve ser chamada depois de display(), que inicializa os painéis
+void display_task_iniciar(UBaseType_t prioridade) {
+    fila_display = xQueueCreate(DISPLAY_FILA_TAMANHO, sizeof(display_msg_t));
+    for (uint8_t i = 0; i < 2; i++) {
+        flush_sem[i] = xSemaphoreCreateBinary();
+        xSemaphoreGive(flush_sem[i]); // Nenhum envio em andamento
+    }
+    for (uint8_t i = 0; i < DISPLAY_PAINEIS; i++) {
+        if (!paineis[i]) {
+            continue;
+        }
+        painel_t *p = &telas[num_telas++];
+        p->ssd = paineis[i];
+        p->sem = flush_sem[i2c_hw_index(p->ssd->i2c_port)];
+        p->dma_ok = ssd1306_dma_init(&p->dma, p->ssd);
+        criar_widgets(p);
+    }
+    xTaskCreate(vTaskDisplay, "Display", DISPLAY_PILHA, NULL, prioridade, NULL);
+}
+
+// Não bloqueia: retorna false se a fila estiver cheia
+bool display_task_enviar(const display_msg_t *msg) {
+    return xQueueSend(fila_display, msg, 0) == pdTRUE;
+}
+
+bool display_task_ocupacao(uint8_t usuarios_ativos, uint8_t capacidade_maxima) {
+    display_msg_t msg = { DISPLAY_MSG_OCUPACAO, usuarios_ativos, capacidade_maxima };
+    return display_task_enviar(&msg);
+}
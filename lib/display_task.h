@@ -0,0 +1,55 @@
+#ifndef DISPLAY_TASK_H
+#define DISPLAY_TASK_H
+
+#include "FreeRTOS.h"
+#include "lib/display_init.h"
+
+// Intervalo mínimo entre quadros enviados ao display (limita o tráfego I2C)
+#ifndef DISPLAY_QUADRO_MS
+#define DISPLAY_QUADRO_MS 50
+#endif
+
+#define DISPLAY_FILA_TAMANHO 8
+
+// Prazo de um envio por DMA; passado esse tempo ele é cancelado como falha
+#ifndef DISPLAY_ENVIO_MAX_MS
+#define DISPLAY_ENVIO_MAX_MS 50
+#endif
+
+// Intervalo entre tentativas de recuperar um display que parou de responder
+#ifndef DISPLAY_RECUPERACAO_MS
+#define DISPLAY_RECUPERACAO_MS 500
+#endif
+
+// Intervalo entre amostras do histórico de ocupação; com uma amostra por
+// coluna, 128 colunas cobrem pouco mais de 10 minutos
+#ifndef DISPLAY_HISTORICO_MS
+#define DISPLAY_HISTORICO_MS 5000
+#endif
+
+// Pilha da tarefa, em palavras; valor não medido, veja g_display_pilha_livre
+#ifndef DISPLAY_PILHA
+#define DISPLAY_PILHA 448
+#endif
+
+// Mensagens compactas consumidas pela tarefa do display
+typedef enum {
+    DISPLAY_MSG_OCUPACAO,   // a = usuários ativos, b = capacidade máxima
+    DISPLAY_MSG_REDESENHAR  // Reenvia a tela inteira
+} display_msg_tipo_t;
+
+typedef struct {
+    uint8_t tipo;
+    uint8_t a, b;
+} display_msg_t;
+
+extern volatile uint32_t g_display_mensagens; // Mensagens recebidas
+extern volatile uint32_t g_display_quadros;   // Quadros desenhados e enviados
+extern volatile uint32_t g_display_desenho_us;  // Duração do último desenho
+extern volatile uint32_t g_display_pilha_livre; // Mínimo de pilha livre (palavras)
+
+void display_task_iniciar(UBaseType_t prioridade);
+bool display_task_enviar(const display_msg_t *msg);
+bool display_task_ocupacao(uint8_t usuarios, uint8_t capacidade);
+
+#endif
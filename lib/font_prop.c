@@ -0,0 +1,348 @@
+// Gerado por tools/gen_font_prop.py a partir de font.h; não edite.
+// Fonte proporcional de 8 linhas: ASCII e letras acentuadas do português.
+
+#include "lib/ssd1306_font.h"
+
+static const uint8_t font_prop_bitmap[783] = {
+  0x00, 0x00, //  
+  0x5F, 0x5F, // !
+  0x07, 0x07, 0x00, 0x07, 0x07, // "
+  0x14, 0x7F, 0x7F, 0x14, 0x7F, 0x7F, 0x14, // #
+  0x24, 0x2E, 0x2A, 0x6B, 0x6B, 0x3A, 0x12, // $
+  0x46, 0x66, 0x30, 0x18, 0x0C, 0x66, 0x62, // %
+  0x30, 0x7A, 0x4F, 0x5D, 0x37, 0x7A, 0x48, // &
+  0x04, 0x07, 0x03, // '
+  0x1C, 0x3E, 0x63, 0x41, // (
+  0x41, 0x63, 0x3E, 0x1C, // )
+  0x08, 0x2A, 0x3E, 0x1C, 0x1C, 0x3E, 0x2A, 0x08, // *
+  0x08, 0x08, 0x3E, 0x3E, 0x08, 0x08, // +
+  0x80, 0xE0, 0x60, // ,
+  0x08, 0x08, 0x08, 0x08, 0x08, 0x08, // -
+  0x60, 0x60, // .
+  0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, // /
+  0x3E, 0x7F, 0x59, 0x4D, 0x47, 0x7F, 0x3E, // 0
+  0x40, 0x42, 0x7F, 0x7F, 0x40, 0x40, // 1
+  0x72, 0x7B, 0x49, 0x49, 0x49, 0x4F, 0x46, // 2
+  0x41, 0x41, 0x49, 0x49, 0x49, 0x7F, 0x36, // 3
+  0x1E, 0x1E, 0x10, 0x10, 0x7F, 0x7F, 0x10, // 4
+  0x27, 0x67, 0x45, 0x45, 0x45, 0x7D, 0x39, // 5
+  0x3E, 0x7F, 0x49, 0x49, 0x49, 0x79, 0x30, // 6
+  0x01, 0x01, 0x61, 0x71, 0x19, 0x0F, 0x07, // 7
+  0x36, 0x7F, 0x49, 0x49, 0x49, 0x7F, 0x36, // 8
+  0x06, 0x4F, 0x49, 0x49, 0x49, 0x7F, 0x3E, // 9
+  0x66, 0x66, // :
+  0x80, 0xE6, 0x66, // ;
+  0x08, 0x1C, 0x36, 0x63, 0x41, // <
+  0x14, 0x14, 0x14, 0x14, 0x14, 0x14, // =
+  0x41, 0x63, 0x36, 0x1C, 0x08, // >
+  0x02, 0x03, 0x59, 0x5D, 0x07, 0x02, // ?
+  0x3E, 0x7F, 0x41, 0x5D, 0x5D, 0x5F, 0x5E, // @
+  0x7C, 0x7E, 0x13, 0x11, 0x13, 0x7E, 0x7C, // A
+  0x7F, 0x7F, 0x49, 0x49, 0x49, 0x7F, 0x36, // B
+  0x3E, 0x7F, 0x41, 0x41, 0x41, 0x63, 0x22, // C
+  0x7F, 0x7F, 0x41, 0x41, 0x63, 0x3E, 0x1C, // D
+  0x7F, 0x7F, 0x49, 0x49, 0x49, 0x41, 0x41, // E
+  0x7F, 0x7F, 0x09, 0x09, 0x09, 0x01, 0x01, // F
+  0x3E, 0x7F, 0x41, 0x41, 0x51, 0x73, 0x32, // G
+  0x7F, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x7F, // H
+  0x41, 0x41, 0x7F, 0x7F, 0x41, 0x41, // I
+  0x20, 0x60, 0x40, 0x40, 0x40, 0x7F, 0x3F, // J
+  0x7F, 0x7F, 0x08, 0x1C, 0x36, 0x63, 0x41, // K
+  0x7F, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x40, // L
+  0x7F, 0x7F, 0x0E, 0x1C, 0x0E, 0x7F, 0x7F, // M
+  0x7F, 0x7F, 0x06, 0x0C, 0x18, 0x7F, 0x7F, // N
+  0x3E, 0x7F, 0x41, 0x41, 0x41, 0x7F, 0x3E, // O
+  0x7F, 0x7F, 0x09, 0x09, 0x09, 0x0F, 0x06, // P
+  0x3E, 0x7F, 0x41, 0x71, 0x61, 0xFF, 0xBE, // Q
+  0x7F, 0x7F, 0x09, 0x19, 0x39, 0x6F, 0x46, // R
+  0x26, 0x6F, 0x49, 0x49, 0x49, 0x7B, 0x32, // S
+  0x01, 0x01, 0x01, 0x7F, 0x7F, 0x01, 0x01, 0x01, // T
+  0x7F, 0x7F, 0x40, 0x40, 0x40, 0x7F, 0x7F, // U
+  0x1F, 0x3F, 0x60, 0x60, 0x60, 0x3F, 0x1F, // V
+  0x3F, 0x7F, 0x60, 0x30, 0x60, 0x7F, 0x3F, // W
+  0x63, 0x77, 0x1C, 0x08, 0x1C, 0x77, 0x63, // X
+  0x47, 0x4F, 0x68, 0x38, 0x18, 0x0F, 0x07, // Y
+  0x41, 0x61, 0x71, 0x59, 0x4D, 0x47, 0x43, // Z
+  0x7F, 0x7F, 0x41, 0x41, // [
+  0x01, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, // barra invertida
+  0x41, 0x41, 0x7F, 0x7F, // ]
+  0x08, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x08, // ^
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, // _
+  0x03, 0x07, 0x04, // `
+  0x20, 0x74, 0x54, 0x54, 0x54, 0x7C, 0x78, // a
+  0x7F, 0x7F, 0x48, 0x48, 0x48, 0x78, 0x30, // b
+  0x38, 0x7C, 0x44, 0x44, 0x44, 0x6C, 0x28, // c
+  0x30, 0x78, 0x48, 0x48, 0x48, 0x7F, 0x7F, // d
+  0x38, 0x7C, 0x54, 0x54, 0x54, 0x5C, 0x18, // e
+  0x48, 0x7E, 0x7F, 0x49, 0x03, 0x02, // f
+  0x98, 0xBC, 0xA4, 0xA4, 0xA4, 0xFC, 0x7C, // g
+  0x7F, 0x7F, 0x04, 0x04, 0x04, 0x7C, 0x78, // h
+  0x44, 0x7D, 0x7D, 0x40, // i
+  0x40, 0xC0, 0x80, 0x80, 0x80, 0xFD, 0x7D, // j
+  0x7F, 0x7F, 0x10, 0x18, 0x3C, 0x64, 0x40, // k
+  0x41, 0x7F, 0x7F, 0x40, // l
+  0x7C, 0x7C, 0x18, 0x78, 0x1C, 0x7C, 0x78, // m
+  0x7C, 0x7C, 0x04, 0x04, 0x04, 0x7C, 0x78, // n
+  0x38, 0x7C, 0x44, 0x44, 0x44, 0x7C, 0x38, // o
+  0xFC, 0xFC, 0x24, 0x24, 0x24, 0x3C, 0x18, // p
+  0x18, 0x3C, 0x24, 0x24, 0x24, 0xFC, 0xFC, // q
+  0x7C, 0x7C, 0x04, 0x04, 0x04, 0x0C, 0x08, // r
+  0x48, 0x5C, 0x54, 0x54, 0x54, 0x74, 0x24, // s
+  0x04, 0x04, 0x3F, 0x7F, 0x44, 0x44, // t
+  0x3C, 0x7C, 0x40, 0x40, 0x40, 0x7C, 0x7C, // u
+  0x1C, 0x3C, 0x60, 0x60, 0x60, 0x3C, 0x1C, // v
+  0x3C, 0x7C, 0x60, 0x30, 0x60, 0x7C, 0x3C, // w
+  0x44, 0x6C, 0x38, 0x10, 0x38, 0x6C, 0x44, // x
+  0x9C, 0xBC, 0xA0, 0xA0, 0xA0, 0xFC, 0x7C, // y
+  0x44, 0x64, 0x74, 0x54, 0x5C, 0x4C, 0x44, // z
+  0x08, 0x08, 0x3E, 0x77, 0x41, 0x41, // {
+  0x77, 0x77, // |
+  0x41, 0x41, 0x77, 0x3E, 0x08, 0x08, // }
+  0x00, 0x00, // ~
+  0x12, 0x15, 0x15, 0x1E, // ª
+  0x06, 0x09, 0x09, 0x06, // °
+  0x12, 0x15, 0x15, 0x12, // º
+  0x78, 0x78, 0x2D, 0x26, 0x2C, 0x78, 0x78, // À
+  0x78, 0x78, 0x2E, 0x25, 0x2C, 0x78, 0x78, // Á
+  0x78, 0x78, 0x2E, 0x25, 0x2E, 0x78, 0x78, // Â
+  0x78, 0x7A, 0x2D, 0x26, 0x2D, 0x78, 0x78, // Ã
+  0x3E, 0x7F, 0xC1, 0xC1, 0x41, 0x63, 0x22, // Ç
+  0x7C, 0x7C, 0x56, 0x55, 0x54, 0x44, 0x44, // É
+  0x7C, 0x7C, 0x56, 0x55, 0x56, 0x44, 0x44, // Ê
+  0x44, 0x44, 0x7E, 0x7D, 0x44, 0x44, // Í
+  0x38, 0x7C, 0x46, 0x45, 0x44, 0x7C, 0x38, // Ó
+  0x38, 0x7C, 0x46, 0x45, 0x46, 0x7C, 0x38, // Ô
+  0x38, 0x7E, 0x45, 0x46, 0x45, 0x7C, 0x38, // Õ
+  0x7C, 0x7C, 0x42, 0x41, 0x40, 0x7C, 0x7C, // Ú
+  0x7C, 0x7C, 0x41, 0x40, 0x41, 0x7C, 0x7C, // Ü
+  0x20, 0x74, 0x55, 0x56, 0x54, 0x7C, 0x78, // à
+  0x20, 0x74, 0x56, 0x55, 0x54, 0x7C, 0x78, // á
+  0x20, 0x74, 0x56, 0x55, 0x56, 0x7C, 0x78, // â
+  0x20, 0x76, 0x55, 0x56, 0x55, 0x7C, 0x78, // ã
+  0x38, 0x7C, 0xC4, 0xC4, 0x44, 0x6C, 0x28, // ç
+  0x38, 0x7C, 0x56, 0x55, 0x54, 0x5C, 0x18, // é
+  0x38, 0x7C, 0x56, 0x55, 0x56, 0x5C, 0x18, // ê
+  0x44, 0x7E, 0x7D, 0x40, // í
+  0x38, 0x7C, 0x46, 0x45, 0x44, 0x7C, 0x38, // ó
+  0x38, 0x7C, 0x46, 0x45, 0x46, 0x7C, 0x38, // ô
+  0x38, 0x7E, 0x45, 0x46, 0x45, 0x7C, 0x38, // õ
+  0x3C, 0x7C, 0x42, 0x41, 0x40, 0x7C, 0x7C, // ú
+  0x3C, 0x7C, 0x41, 0x40, 0x41, 0x7C, 0x7C, // ü
+  0x7E, 0x42, 0x42, 0x42, 0x7E, // substituto
+};
+
+static const ssd1306_glyph_t font_prop_glyphs[193] = {
+  {    0, 2 }, // U+0020
+  {    2, 2 }, // U+0021
+  {    4, 5 }, // U+0022
+  {    9, 7 }, // U+0023
+  {   16, 7 }, // U+0024
+  {   23, 7 }, // U+0025
+  {   30, 7 }, // U+0026
+  {   37, 3 }, // U+0027
+  {   40, 4 }, // U+0028
+  {   44, 4 }, // U+0029
+  {   48, 8 }, // U+002A
+  {   56, 6 }, // U+002B
+  {   62, 3 }, // U+002C
+  {   65, 6 }, // U+002D
+  {   71, 2 }, // U+002E
+  {   73, 7 }, // U+002F
+  {   80, 7 }, // U+0030
+  {   87, 6 }, // U+0031
+  {   93, 7 }, // U+0032
+  {  100, 7 }, // U+0033
+  {  107, 7 }, // U+0034
+  {  114, 7 }, // U+0035
+  {  121, 7 }, // U+0036
+  {  128, 7 }, // U+0037
+  {  135, 7 }, // U+0038
+  {  142, 7 }, // U+0039
+  {  149, 2 }, // U+003A
+  {  151, 3 }, // U+003B
+  {  154, 5 }, // U+003C
+  {  159, 6 }, // U+003D
+  {  165, 5 }, // U+003E
+  {  170, 6 }, // U+003F
+  {  176, 7 }, // U+0040
+  {  183, 7 }, // U+0041
+  {  190, 7 }, // U+0042
+  {  197, 7 }, // U+0043
+  {  204, 7 }, // U+0044
+  {  211, 7 }, // U+0045
+  {  218, 7 }, // U+0046
+  {  225, 7 }, // U+0047
+  {  232, 7 }, // U+0048
+  {  239, 6 }, // U+0049
+  {  245, 7 }, // U+004A
+  {  252, 7 }, // U+004B
+  {  259, 7 }, // U+004C
+  {  266, 7 }, // U+004D
+  {  273, 7 }, // U+004E
+  {  280, 7 }, // U+004F
+  {  287, 7 }, // U+0050
+  {  294, 7 }, // U+0051
+  {  301, 7 }, // U+0052
+  {  308, 7 }, // U+0053
+  {  315, 8 }, // U+0054
+  {  323, 7 }, // U+0055
+  {  330, 7 }, // U+0056
+  {  337, 7 }, // U+0057
+  {  344, 7 }, // U+0058
+  {  351, 7 }, // U+0059
+  {  358, 7 }, // U+005A
+  {  365, 4 }, // U+005B
+  {  369, 7 }, // U+005C
+  {  376, 4 }, // U+005D
+  {  380, 7 }, // U+005E
+  {  387, 8 }, // U+005F
+  {  395, 3 }, // U+0060
+  {  398, 7 }, // U+0061
+  {  405, 7 }, // U+0062
+  {  412, 7 }, // U+0063
+  {  419, 7 }, // U+0064
+  {  426, 7 }, // U+0065
+  {  433, 6 }, // U+0066
+  {  439, 7 }, // U+0067
+  {  446, 7 }, // U+0068
+  {  453, 4 }, // U+0069
+  {  457, 7 }, // U+006A
+  {  464, 7 }, // U+006B
+  {  471, 4 }, // U+006C
+  {  475, 7 }, // U+006D
+  {  482, 7 }, // U+006E
+  {  489, 7 }, // U+006F
+  {  496, 7 }, // U+0070
+  {  503, 7 }, // U+0071
+  {  510, 7 }, // U+0072
+  {  517, 7 }, // U+0073
+  {  524, 6 }, // U+0074
+  {  530, 7 }, // U+0075
+  {  537, 7 }, // U+0076
+  {  544, 7 }, // U+0077
+  {  551, 7 }, // U+0078
+  {  558, 7 }, // U+0079
+  {  565, 7 }, // U+007A
+  {  572, 6 }, // U+007B
+  {  578, 2 }, // U+007C
+  {  580, 6 }, // U+007D
+  {  586, 2 }, // U+007E
+  {  588, 0 }, // U+007F
+  {  588, 0 }, // U+00A0
+  {  588, 0 }, // U+00A1
+  {  588, 0 }, // U+00A2
+  {  588, 0 }, // U+00A3
+  {  588, 0 }, // U+00A4
+  {  588, 0 }, // U+00A5
+  {  588, 0 }, // U+00A6
+  {  588, 0 }, // U+00A7
+  {  588, 0 }, // U+00A8
+  {  588, 0 }, // U+00A9
+  {  588, 4 }, // U+00AA
+  {  592, 0 }, // U+00AB
+  {  592, 0 }, // U+00AC
+  {  592, 0 }, // U+00AD
+  {  592, 0 }, // U+00AE
+  {  592, 0 }, // U+00AF
+  {  592, 4 }, // U+00B0
+  {  596, 0 }, // U+00B1
+  {  596, 0 }, // U+00B2
+  {  596, 0 }, // U+00B3
+  {  596, 0 }, // U+00B4
+  {  596, 0 }, // U+00B5
+  {  596, 0 }, // U+00B6
+  {  596, 0 }, // U+00B7
+  {  596, 0 }, // U+00B8
+  {  596, 0 }, // U+00B9
+  {  596, 4 }, // U+00BA
+  {  600, 0 }, // U+00BB
+  {  600, 0 }, // U+00BC
+  {  600, 0 }, // U+00BD
+  {  600, 0 }, // U+00BE
+  {  600, 0 }, // U+00BF
+  {  600, 7 }, // U+00C0
+  {  607, 7 }, // U+00C1
+  {  614, 7 }, // U+00C2
+  {  621, 7 }, // U+00C3
+  {  628, 0 }, // U+00C4
+  {  628, 0 }, // U+00C5
+  {  628, 0 }, // U+00C6
+  {  628, 7 }, // U+00C7
+  {  635, 0 }, // U+00C8
+  {  635, 7 }, // U+00C9
+  {  642, 7 }, // U+00CA
+  {  649, 0 }, // U+00CB
+  {  649, 0 }, // U+00CC
+  {  649, 6 }, // U+00CD
+  {  655, 0 }, // U+00CE
+  {  655, 0 }, // U+00CF
+  {  655, 0 }, // U+00D0
+  {  655, 0 }, // U+00D1
+  {  655, 0 }, // U+00D2
+  {  655, 7 }, // U+00D3
+  {  662, 7 }, // U+00D4
+  {  669, 7 }, // U+00D5
+  {  676, 0 }, // U+00D6
+  {  676, 0 }, // U+00D7
+  {  676, 0 }, // U+00D8
+  {  676, 0 }, // U+00D9
+  {  676, 7 }, // U+00DA
+  {  683, 0 }, // U+00DB
+  {  683, 7 }, // U+00DC
+  {  690, 0 }, // U+00DD
+  {  690, 0 }, // U+00DE
+  {  690, 0 }, // U+00DF
+  {  690, 7 }, // U+00E0
+  {  697, 7 }, // U+00E1
+  {  704, 7 }, // U+00E2
+  {  711, 7 }, // U+00E3
+  {  718, 0 }, // U+00E4
+  {  718, 0 }, // U+00E5
+  {  718, 0 }, // U+00E6
+  {  718, 7 }, // U+00E7
+  {  725, 0 }, // U+00E8
+  {  725, 7 }, // U+00E9
+  {  732, 7 }, // U+00EA
+  {  739, 0 }, // U+00EB
+  {  739, 0 }, // U+00EC
+  {  739, 4 }, // U+00ED
+  {  743, 0 }, // U+00EE
+  {  743, 0 }, // U+00EF
+  {  743, 0 }, // U+00F0
+  {  743, 0 }, // U+00F1
+  {  743, 0 }, // U+00F2
+  {  743, 7 }, // U+00F3
+  {  750, 7 }, // U+00F4
+  {  757, 7 }, // U+00F5
+  {  764, 0 }, // U+00F6
+  {  764, 0 }, // U+00F7
+  {  764, 0 }, // U+00F8
+  {  764, 0 }, // U+00F9
+  {  764, 7 }, // U+00FA
+  {  771, 0 }, // U+00FB
+  {  771, 7 }, // U+00FC
+  {  778, 0 }, // U+00FD
+  {  778, 0 }, // U+00FE
+  {  778, 0 }, // U+00FF
+  {  778, 5 }, // substituto
+};
+
+static const uint16_t font_prop_blocks[8] = {
+  SSD1306_FONT_NO_BLOCK, // U+0000
+  0, // U+0020
+  32, // U+0040
+  64, // U+0060
+  SSD1306_FONT_NO_BLOCK, // U+0080
+  96, // U+00A0
+  128, // U+00C0
+  160, // U+00E0
+};
+
+const ssd1306_font_t ssd1306_font_prop = {
+  font_prop_bitmap,
+  font_prop_glyphs,
+  font_prop_blocks,
+  8,   // Blocos
+  192, // Glifo substituto
+  1,   // Colunas entre glifos
+};
@@ -1,15 +1,99 @@
+#include <string.h>
 #include "lib/matrixws.h"
 #include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
 #include "lib/ws2818b.pio.h"
+#include "lib/gamma.h"
+
+// Quando o DMA termina, ainda há até 8 palavras no FIFO (TX juntado) e 1 no
+// registrador de saída: 9 LEDs x 24 bits x 1,25 us. O intervalo de reset só
+// começa a contar depois que elas saem.
+#define DRENO_US (9 * 24 * 5 / 4)
+#define RESET_US 100  // Intervalo em nível baixo que trava as cores nos LEDs
+
+typedef enum {
+    MATRIZ_LIVRE,     // Linha parada, pronta para um quadro
+    MATRIZ_ENVIANDO,  // DMA alimentando o FIFO da state machine
+    MATRIZ_TRAVANDO   // DMA concluído, aguardando o alarme do reset
+} matriz_estado_t;
 
 npLED_t leds[NUM_LEDS];  // Vetor que armazena as cores de todos os LEDs
 PIO np_pio;              // PIO utilizado para comunicação com os LEDs
 uint sm;                 // State machine associada ao PIO
 uint8_t brilho_global = BRILHO_PADRAO; // Brilho global inicial
+volatile uint32_t g_matriz_monta_us = 0;
+volatile uint32_t g_matriz_monta_max_us = 0;
+
+// Gama e brilho global combinados: valor do fio para cada valor de leds[],
+// em ponto fixo 8.8 (0 a brilho_global * 256). Refeita por set_brilho(),
+// para o quadro custar três consultas por LED. Sem pontilhado a fração é
+// arredondada; com ele, vai para o acumulador do canal. São duas cópias:
+// set_brilho() monta a que não está em uso e só então troca o ponteiro, para
+// o tique do pontilhado (em interrupção) nunca ler uma tabela pela metade.
+static uint16_t tabelas[2][256];
+static const uint16_t *volatile tabela = tabelas[0];
+
+// Pontilhado temporal: fração (1/256) que cada canal ainda deve à linha.
+// Somada ao próximo quadro, faz a média no tempo chegar ao valor da tabela.
+static uint8_t erro[NUM_LEDS][3];
+static volatile bool pontilhado;
+static repeating_timer_t timer_pontilhado;
+
+// Quadros prontos para o fio (uma palavra GRB por LED, já com brilho): um em
+// envio pelo DMA e outro livre para o próximo bf()
+static uint32_t quadro[2][NUM_LEDS];
+static uint8_t atual;               // Quadro enviado por último
+static volatile uint8_t estado = MATRIZ_LIVRE;
+static volatile bool pendente;      // Quadro 1 - atual espera a linha liberar
+static uint canal;                  // Canal DMA ligado ao FIFO da state machine
+static uint alarme;                 // Alarme do timer que mede o reset
+static matriz_callback_t concluido; // Chamado (em interrupção) a cada quadro travado
+static void *concluido_arg;
+
+// Chamada com interrupções desligadas ou de dentro de uma interrupção
+static void matriz_inicia(uint8_t indice) {
+    atual = indice;
+    pendente = false;
+    estado = MATRIZ_ENVIANDO;
+    dma_channel_transfer_from_buffer_now(canal, quadro[indice], NUM_LEDS);
+}
+
+// Fim do reset: os LEDs já mostram o quadro; começa o pendente, se houver
+static void matriz_alarme(uint num) {
+    (void) num;
+    estado = MATRIZ_LIVRE;
+    if (concluido)
+        concluido(concluido_arg);
+    if (pendente)
+        matriz_inicia(1 - atual);
+}
+
+// O último byte foi para o FIFO: agenda o fim do reset em vez de esperar
+static void matriz_dma_irq(void) {
+    if (!dma_channel_get_irq0_status(canal))
+        return;
+    dma_channel_acknowledge_irq0(canal);
+    estado = MATRIZ_TRAVANDO;
+    if (hardware_alarm_set_target(alarme, make_timeout_time_us(DRENO_US + RESET_US)))
+        matriz_alarme(alarme); // Prazo já passou
+}
 
 // Função para ajustar o brilho global
 void set_brilho(uint8_t brilho) {
-    brilho_global = (brilho > BRILHO_MAX) ? BRILHO_MAX : brilho;
+#if BRILHO_MAX < 255
+    brilho = (brilho > BRILHO_MAX) ? BRILHO_MAX : brilho;
+#endif
+    uint16_t *nova = tabela == tabelas[0] ? tabelas[1] : tabelas[0];
+    for (uint i = 0; i < 256; ++i)
+        nova[i] = ((uint32_t) gamma16[i] * brilho * 256 + 32767) / 65535;
+
+    uint32_t irq = save_and_disable_interrupts();
+    tabela = nova;
+    brilho_global = brilho;
+    restore_interrupts(irq);
 }
 
 // Função para converter as posições (x, y) da matriz para um índice do vetor de LEDs
@@ -21,19 +105,109 @@ int getIndex(int x, int y) {
     }
 }
 
-// Função para atualizar os LEDs da matriz com controle de brilho
+static inline uint32_t pontilha(const uint16_t *t, uint8_t valor, uint8_t *acumulado) {
+    uint16_t v = t[valor] + *acumulado;
+    *acumulado = v & 0xFF;
+    return v >> 8;
+}
+
+// Monta o quadro livre a partir de leds[] e o envia. Se a linha estiver
+// ocupada, o quadro fica pendente e substitui qualquer outro pendente.
+// Tudo numa seção crítica (75 consultas à tabela): se uma tarefa pudesse
+// interromper a montagem, duas chamadas a set_brilho() reescreveriam a
+// tabela em uso.
+static void matriz_monta(void) {
+    uint32_t inicio = time_us_32();
+    uint32_t irq = save_and_disable_interrupts();
+    pendente = false; // O quadro livre vai ser reescrito
+    uint8_t alvo = 1 - atual;
+    const uint16_t *t = tabela;
+    uint32_t *p = quadro[alvo];
+    if (pontilhado) {
+        for (uint i = 0; i < NUM_LEDS; ++i) {
+            p[i] = pontilha(t, leds[i].G, &erro[i][0]) << 24 |
+                   pontilha(t, leds[i].R, &erro[i][1]) << 16 |
+                   pontilha(t, leds[i].B, &erro[i][2]) << 8;
+        }
+    } else {
+        for (uint i = 0; i < NUM_LEDS; ++i) {
+            // Aplica gama e brilho global a cada componente, na ordem do fio
+            p[i] = (uint32_t) ((t[leds[i].G] + 128) >> 8) << 24 |
+                   (uint32_t) ((t[leds[i].R] + 128) >> 8) << 16 |
+                   (uint32_t) ((t[leds[i].B] + 128) >> 8) << 8;
+        }
+    }
+
+    if (estado == MATRIZ_LIVRE)
+        matriz_inicia(alvo);
+    else
+        pendente = true;
+    restore_interrupts(irq);
+
+    uint32_t duracao = time_us_32() - inicio;
+    g_matriz_monta_us = duracao;
+    if (duracao > g_matriz_monta_max_us)
+        g_matriz_monta_max_us = duracao;
+}
+
+// Tique do pontilhado: um quadro novo por período, se a linha já travou o
+// anterior (um quadro descartado deixaria o erro fora de sincronia)
+static bool matriz_tique(repeating_timer_t *t) {
+    (void) t;
+    if (!matriz_ocupada())
+        matriz_monta();
+    return true;
+}
+
+// Função para atualizar os LEDs da matriz com controle de brilho. Só monta
+// o quadro: o envio é do DMA e o reset, do alarme. Com o pontilhado ligado
+// nem isso: o próximo tique do timer já parte do leds[] atual.
 void bf() {
-    for (uint i = 0; i < NUM_LEDS; ++i) {
-        // Aplica o brilho global a cada componente de cor
-        uint8_t r = (leds[i].R * brilho_global) / BRILHO_MAX;
-        uint8_t g = (leds[i].G * brilho_global) / BRILHO_MAX;
-        uint8_t b = (leds[i].B * brilho_global) / BRILHO_MAX;
-        
-        pio_sm_put_blocking(np_pio, sm, g);
-        pio_sm_put_blocking(np_pio, sm, r);
-        pio_sm_put_blocking(np_pio, sm, b);
+    if (!pontilhado)
+        matriz_monta();
+}
+
+bool matriz_pontilhado(uint hz) {
+    if (pontilhado) {
+        cancel_repeating_timer(&timer_pontilhado);
+        pontilhado = false;
     }
-    sleep_us(100); // Aguarda 100 microsegundos para estabilizar
+    memset(erro, 0, sizeof(erro));
+    if (hz) {
+        pontilhado = true;
+        // Período negativo: conta do início de um tique ao do próximo
+        if (add_repeating_timer_us(-(int64_t) (1000000 / hz), matriz_tique, NULL, &timer_pontilhado))
+            return true;
+        pontilhado = false;
+    }
+    bf();
+    return hz == 0;
+}
+
+bool matriz_ocupada(void) {
+    return estado != MATRIZ_LIVRE || pendente;
+}
+
+void matriz_callback(matriz_callback_t callback, void *arg) {
+    uint32_t irq = save_and_disable_interrupts();
+    concluido = callback;
+    concluido_arg = arg;
+    restore_interrupts(irq);
+}
+
+// Como ws2818b_program_init(), mas com uma palavra de 24 bits por LED
+// deslocada para a esquerda: o WS2812 recebe G, R e B do bit mais
+// significativo para o menos significativo.
+static void matriz_pio_init(PIO pio, uint sm, uint offset, uint pin, float freq) {
+    pio_gpio_init(pio, pin);
+    pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, true);
+    pio_sm_config c = ws2818b_program_get_default_config(offset);
+    sm_config_set_sideset_pins(&c, pin);
+    sm_config_set_out_shift(&c, false, true, 24);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+    sm_config_set_clkdiv(&c, clock_get_hz(clk_sys) / (10.f * freq));
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
 }
 
 // Função de controle inicial da matriz de LEDs
@@ -41,7 +215,24 @@ void controle(uint pino) {
     uint offset = pio_add_program(pio0, &ws2818b_program);
     np_pio = pio0;
     sm = pio_claim_unused_sm(np_pio, true);
-    ws2818b_program_init(np_pio, sm, offset, pino, 800000.f);
+    matriz_pio_init(np_pio, sm, offset, pino, 800000.f);
+    set_brilho(brilho_global); // Monta a tabela de gama e brilho
+
+    // Uma palavra por LED no FIFO, no ritmo pedido pela state machine
+    canal = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(canal);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(np_pio, sm, true));
+    dma_channel_configure(canal, &c, &np_pio->txf[sm], quadro[0], 0, false);
+
+    alarme = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarme, matriz_alarme);
+
+    dma_channel_set_irq0_enabled(canal, true);
+    irq_add_shared_handler(DMA_IRQ_0, matriz_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
 
     desliga(); // Inicializa todos os LEDs desligados
 }
@@ -8,22 +8,44 @@
 #define NUM_LEDS 25         // Número total de LEDs na matriz
 #define BRILHO_MAX 255      // Brilho máximo (0-255)
 #define BRILHO_PADRAO 30    // Brilho padrão (30/255 ≈ 12%)
+#define MATRIZ_PONTILHADO_HZ 400  // Taxa sugerida para matriz_pontilhado() (um quadro leva ~1,1 ms)
 
-// Definição da estrutura de cor para cada LED
-typedef struct {
-    uint8_t R, G, B;       // Componentes de cor: vermelho, verde e azul
+// Definição da estrutura de cor para cada LED. Os campos sobrepõem uma
+// palavra na ordem do fio (little-endian): G nos bits 31-24, R em 23-16,
+// B em 15-8, como as palavras que bf() monta após gama e brilho.
+typedef union {
+    struct {
+        uint8_t _livre, B, R, G;  // Componentes de cor: vermelho, verde e azul
+    };
+    uint32_t grb;                 // Os três componentes numa palavra
 } npLED_t;
 
+// Chamado de dentro de uma interrupção quando um quadro termina de travar
+typedef void (*matriz_callback_t)(void *arg);
+
 extern npLED_t leds[NUM_LEDS];  // Vetor que armazena as cores de todos os LEDs
-extern uint8_t brilho_global;   // Variável global para controle de brilho
+extern uint8_t brilho_global;   // Variável global para controle de brilho (mude por set_brilho())
+
+// Medições na placa (time_us_32): duração da última montagem de quadro
+// (tabela de gama e brilho, ou pontilhado, para os 25 LEDs) e a maior vista.
+// A montagem roda com as interrupções desligadas; é esse o tempo medido.
+extern volatile uint32_t g_matriz_monta_us;
+extern volatile uint32_t g_matriz_monta_max_us;
 
 // Funções
 void controle(uint pino);       // Função de controle inicial da matriz de LEDs
-void bf();                     // Função para atualizar os LEDs da matriz
+void bf();                     // Função para atualizar os LEDs da matriz (não bloqueia)
+bool matriz_ocupada(void);     // Quadro em envio, em reset ou pendente
+void matriz_callback(matriz_callback_t callback, void *arg);  // Aviso de quadro travado
+// Pontilhado temporal: com hz > 0, um timer renova a matriz hz vezes por
+// segundo e cada canal acumula a fração que o brilho baixo arredondaria,
+// dando ~256 níveis entre dois valores inteiros; bf() passa a não custar
+// nada. hz = 0 desliga. Retorna false se o timer não pôde ser criado.
+bool matriz_pontilhado(uint hz);
 void cores(const uint indice, const uint8_t r, const uint8_t g, const uint8_t b);  // Função para configurar a cor de um LED
 void desliga();                // Função para desligar todos os LEDs
 void desenhaMatriz(int mat[5][5][3]);  // Função para desenhar a matriz de LEDs
-void set_brilho(uint8_t brilho);       // Função para ajustar o brilho global
+void set_brilho(uint8_t brilho);       // Função para ajustar o brilho global (refaz a tabela de gama)
 void sequencia_rgb();          // Função para testar sequência RGB
 int getIndex(int x, int y);    
 #endif
\ No newline at end of file
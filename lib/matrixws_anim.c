@@ -0,0 +1,145 @@
+#include <string.h>
+#include "lib/matrixws_anim.h"
+#include "task.h"
+#include "queue.h"
+
+// Animação por quadros-chave na matriz WS2812. Entre dois quadros cada
+// componente é interpolado em ponto fixo (peso de 0 a 256) pelo tempo
+// decorrido desde o início do quadro, não pelo número de passos: uma
+// tarefa atrasada pula direto para onde a animação deveria estar. Fora
+// das transições a tarefa dorme até o fim da pausa.
+
+typedef enum {
+    ANIM_TOCAR,
+    ANIM_TRANSICAO,
+    ANIM_PARAR
+} anim_cmd_t;
+
+typedef struct {
+    uint8_t tipo;
+    const matriz_anim_t *anim; // ANIM_TOCAR
+    matriz_quadro_t quadro;    // ANIM_TRANSICAO
+} anim_msg_t;
+
+volatile uint32_t g_matriz_pilha_livre = 0;
+
+// Fila de um só comando: um comando novo substitui o que não foi lido
+static QueueHandle_t fila_anim;
+
+// Estado da tarefa
+static const matriz_anim_t *tocando; // NULL: parada
+static matriz_anim_t unica;          // Animação de matriz_anim_transicao()
+static matriz_quadro_t quadro_unico;
+static uint8_t indice;               // Quadro-chave de destino
+static bool chegou;                  // Quadro de destino já exibido
+static TickType_t inicio;            // Início da transição para indice
+static uint8_t origem[NUM_LEDS][3];  // Matriz no início da transição
+
+// Mistura origem e destino com peso / 256 do destino e envia o quadro
+static void mostrar(const uint8_t destino[NUM_LEDS][3], uint16_t peso) {
+    for (uint i = 0; i < NUM_LEDS; ++i) {
+        uint8_t c[3];
+        for (uint k = 0; k < 3; ++k)
+            c[k] = (origem[i][k] * (256 - peso) + destino[i][k] * peso) >> 8;
+        cores(i, c[0], c[1], c[2]);
+    }
+    bf();
+}
+
+static void comecar(const matriz_anim_t *anim) {
+    for (uint i = 0; i < NUM_LEDS; ++i) {
+        origem[i][0] = leds[i].R;
+        origem[i][1] = leds[i].G;
+        origem[i][2] = leds[i].B;
+    }
+    tocando = anim;
+    indice = 0;
+    chegou = false;
+    inicio = xTaskGetTickCount();
+}
+
+// Exibe o ponto atual da animação e retorna quanto dormir até o próximo
+static TickType_t avancar(void) {
+    TickType_t agora = xTaskGetTickCount();
+
+    // No máximo uma volta completa: quadros sem duração não prendem a tarefa
+    for (uint n = 0; n <= tocando->total; ++n) {
+        const matriz_quadro_t *q = &tocando->quadros[indice];
+        uint32_t t = (agora - inicio) * portTICK_PERIOD_MS;
+        if (t < q->transicao_ms) {
+            mostrar(q->rgb, (t << 8) / q->transicao_ms);
+            return pdMS_TO_TICKS(MATRIZ_ANIM_PASSO_MS);
+        }
+        if (!chegou) {
+            mostrar(q->rgb, 256);
+            chegou = true;
+        }
+        uint32_t fim = q->transicao_ms + q->pausa_ms;
+        if (t < fim)
+            return pdMS_TO_TICKS(fim - t);
+
+        // O próximo quadro parte deste, no instante em que este terminou
+        memcpy(origem, q->rgb, sizeof(origem));
+        inicio += pdMS_TO_TICKS(fim);
+        chegou = false;
+        if (++indice == tocando->total) {
+            if (!tocando->repete) {
+                tocando = NULL;
+                return portMAX_DELAY;
+            }
+            indice = 0;
+        }
+    }
+    inicio = agora;
+    return pdMS_TO_TICKS(MATRIZ_ANIM_PASSO_MS);
+}
+
+static void vTaskMatriz(void *pvParameters) {
+    (void) pvParameters;
+    TickType_t espera = portMAX_DELAY;
+    anim_msg_t msg;
+
+    for (;;) {
+        if (xQueueReceive(fila_anim, &msg, espera) == pdTRUE) {
+            switch (msg.tipo) {
+            case ANIM_TOCAR:
+                if (msg.anim && msg.anim->total)
+                    comecar(msg.anim);
+                break;
+            case ANIM_TRANSICAO:
+                quadro_unico = msg.quadro;
+                unica.quadros = &quadro_unico;
+                unica.total = 1;
+                unica.repete = false;
+                comecar(&unica);
+                break;
+            case ANIM_PARAR:
+                tocando = NULL;
+                break;
+            }
+        }
+        espera = tocando ? avancar() : portMAX_DELAY;
+        g_matriz_pilha_livre = uxTaskGetStackHighWaterMark(NULL);
+    }
+}
+
+void matriz_anim_iniciar(UBaseType_t prioridade) {
+    fila_anim = xQueueCreate(1, sizeof(anim_msg_t));
+    xTaskCreate(vTaskMatriz, "Matriz", MATRIZ_ANIM_PILHA, NULL, prioridade, NULL);
+}
+
+// Não bloqueiam: o comando substitui um anterior ainda não lido
+bool matriz_anim_tocar(const matriz_anim_t *anim) {
+    anim_msg_t msg = { .tipo = ANIM_TOCAR, .anim = anim };
+    return xQueueOverwrite(fila_anim, &msg) == pdPASS;
+}
+
+bool matriz_anim_transicao(const matriz_quadro_t *quadro) {
+    anim_msg_t msg = { .tipo = ANIM_TRANSICAO, .quadro = *quadro };
+    return xQueueOverwrite(fila_anim, &msg) == pdPASS;
+}
+
+bool matriz_anim_parar(void) {
+    anim_msg_t msg = { .tipo = ANIM_PARAR };
+    return xQueueOverwrite(fila_anim, &msg) == pdPASS;
+}
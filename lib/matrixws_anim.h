@@ -0,0 +1,50 @@
+#ifndef MATRIXWS_ANIM_H
+#define MATRIXWS_ANIM_H
+
+#include "FreeRTOS.h"
+#include "lib/matrixws.h"
+
+// Intervalo entre quadros interpolados (50 quadros por segundo)
+#ifndef MATRIZ_ANIM_PASSO_MS
+#define MATRIZ_ANIM_PASSO_MS 20
+#endif
+
+// Pilha da tarefa, em palavras (sem medição na placa ainda)
+#ifndef MATRIZ_ANIM_PILHA
+#define MATRIZ_ANIM_PILHA 320
+#endif
+
+// Mínimo de pilha livre da tarefa (palavras), por uxTaskGetStackHighWaterMark()
+extern volatile uint32_t g_matriz_pilha_livre;
+
+// Quadro-chave: a cor de cada LED (índice de leds[]), o tempo para chegar
+// a ele a partir do quadro anterior e o tempo parado nele
+typedef struct {
+    uint8_t rgb[NUM_LEDS][3];
+    uint16_t transicao_ms; // 0: troca direta
+    uint16_t pausa_ms;
+} matriz_quadro_t;
+
+typedef struct {
+    const matriz_quadro_t *quadros;
+    uint8_t total;
+    bool repete; // Volta ao primeiro quadro, interpolando a partir do último
+} matriz_anim_t;
+
+// A tarefa da animação é a dona da matriz enquanto toca: as demais tarefas
+// só enviam comandos (o último vence), sem esperar. Nada de sleep_ms: a
+// tarefa dorme entre quadros e, parada, fica bloqueada na fila.
+void matriz_anim_iniciar(UBaseType_t prioridade);
+
+// Toca a animação a partir do conteúdo atual da matriz; anim e os quadros
+// devem continuar válidos enquanto ela toca. Uma animação sem repetição
+// termina parada no último quadro.
+bool matriz_anim_tocar(const matriz_anim_t *anim);
+
+// Transição única até o quadro dado, que é copiado
+bool matriz_anim_transicao(const matriz_quadro_t *quadro);
+
+// Cancela a animação em curso, deixando a matriz como está
+bool matriz_anim_parar(void);
+
+#endif
@@ -1,117 +1,581 @@
+#include <string.h>
 #include "ssd1306.h"
 #include "font.h"
+#include "hardware/gpio.h"
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+#ifdef SSD1306_FIXED_GEOMETRY
+static uint8_t ssd1306_static_buffers[SSD1306_STATIC_BUFFERS][WIDTH * HEIGHT / 8 + 1];
+static uint8_t ssd1306_static_used = 0;
+#endif
+
+// Inicializa só o que é preciso para falar com o painel, sem framebuffer
+// (usado diretamente pelo renderizador em faixas de ssd1306_tiles.h)
+void ssd1306_init_bus(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+#ifdef SSD1306_FIXED_GEOMETRY
+  // A geometria passada é ignorada: vale a de compilação
+  width = WIDTH;
+  height = HEIGHT;
+#endif
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
   ssd->address = address;
   ssd->i2c_port = i2c;
+  ssd->external_vcc = external_vcc;
   ssd->bufsize = ssd->pages * ssd->width + 1;
+  ssd->ram_buffer = NULL;
+  ssd->port_buffer[0] = 0x80;
+  ssd->dirty = false;
+  ssd->i2c_transactions = 0;
+  ssd->i2c_bytes = 0;
+  ssd->hash_valid = 0;
+  ssd->bytes_sent = 0;
+  ssd->bytes_skipped = 0;
+  ssd->online = true;
+  ssd->sda_pin = SSD1306_NO_PIN;
+  ssd->scl_pin = SSD1306_NO_PIN;
+  ssd->i2c_errors = 0;
+  ssd->i2c_recoveries = 0;
+  ssd->flush_max_us = 0;
+  ssd->scroll_pages = 0;
+}
+
+// Retorna false, com ram_buffer NULL, se não há framebuffer para o painel:
+// todos os SSD1306_STATIC_BUFFERS já em uso ou calloc() sem memória
+bool ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+  ssd1306_init_bus(ssd, width, height, external_vcc, address, i2c);
+#ifdef SSD1306_FIXED_GEOMETRY
+  if (ssd1306_static_used < SSD1306_STATIC_BUFFERS)
+    ssd->ram_buffer = ssd1306_static_buffers[ssd1306_static_used++];
+#else
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+#endif
+  if (!ssd->ram_buffer)
+    return false;
   ssd->ram_buffer[0] = 0x40;
-  ssd->port_buffer[0] = 0x80;
+  return true;
 }
 
+// Sequência de inicialização enviada numa única transação de comandos
+static const uint8_t ssd1306_init_sequence[] = {
+  SET_DISP | 0x00,
+  SET_SCROLL_OFF,
+  SET_MEM_ADDR, SSD1306_MEM_ADDR_MODE,
+  SET_DISP_START_LINE | 0x00,
+  SET_SEG_REMAP | 0x01,
+  SET_MUX_RATIO, HEIGHT - 1,
+  SET_COM_OUT_DIR | 0x08,
+  SET_DISP_OFFSET, 0x00,
+  SET_COM_PIN_CFG, 0x12,
+  SET_DISP_CLK_DIV, 0x80,
+  SET_PRECHARGE, 0xF1,
+  SET_VCOM_DESEL, 0x30,
+  SET_CONTRAST, 0xFF,
+  SET_ENTIRE_ON,
+  SET_NORM_INV,
+  SET_CHARGE_PUMP, 0x14,
+  SET_DISP | 0x01
+};
+
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  ssd->scroll_pages = 0;
+  ssd1306_command_list(ssd, ssd1306_init_sequence, sizeof(ssd1306_init_sequence));
 }
 
-void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-  ssd->port_buffer[1] = command;
-  i2c_write_blocking(
+// Toda escrita no barramento passa por aqui para manter os contadores. Cada
+// escrita tem prazo; um NACK ou prazo estourado deixa o driver offline e as
+// escritas seguintes retornam na hora, de modo que um envio bloqueia no
+// máximo o tempo das escritas bem-sucedidas mais um prazo.
+static int ssd1306_i2c_write(ssd1306_t *ssd, const uint8_t *buffer, size_t len, bool nostop) {
+  if (!ssd->online)
+    return PICO_ERROR_GENERIC;
+  ssd->i2c_transactions++;
+  ssd->i2c_bytes += len + 1; // + byte de endereço
+  int ret = i2c_write_timeout_us(
     ssd->i2c_port,
     ssd->address,
-    ssd->port_buffer,
-    2,
-    false
+    buffer,
+    len,
+    nostop,
+    SSD1306_I2C_TIMEOUT_US + len * SSD1306_I2C_BYTE_US
   );
+  if (ret != (int)len)
+    ssd1306_i2c_fault(ssd);
+  return ret;
 }
 
-void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+// Registra uma falha de barramento. O conteúdo do painel passa a ser
+// desconhecido, então os hashes de página deixam de valer. Também chamada
+// pelo envio por DMA, no contexto da interrupção.
+void ssd1306_i2c_fault(ssd1306_t *ssd) {
+  ssd->online = false;
+  ssd->hash_valid = 0;
+  ssd->i2c_errors++;
 }
 
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
-  uint8_t pixel = (y & 0b111);
-  if (value)
-    ssd->ram_buffer[index] |= (1 << pixel);
+// Pinos usados por ssd1306_recover() para liberar o barramento
+void ssd1306_set_bus_pins(ssd1306_t *ssd, uint8_t sda, uint8_t scl) {
+  ssd->sda_pin = sda;
+  ssd->scl_pin = scl;
+}
+
+// Libera um escravo preso no meio de um byte segurando SDA em nível baixo:
+// até 9 pulsos em SCL e uma condição de STOP, com os pinos em modo GPIO
+static void ssd1306_bus_clear(ssd1306_t *ssd) {
+  uint sda = ssd->sda_pin, scl = ssd->scl_pin;
+  i2c_get_hw(ssd->i2c_port)->enable = 0;
+
+  gpio_set_function(sda, GPIO_FUNC_SIO);
+  gpio_set_function(scl, GPIO_FUNC_SIO);
+  gpio_set_dir(sda, GPIO_IN);
+  gpio_put(scl, 1);
+  gpio_set_dir(scl, GPIO_OUT);
+  for (uint8_t i = 0; i < 9 && !gpio_get(sda); ++i) {
+    gpio_put(scl, 0);
+    sleep_us(5);
+    gpio_put(scl, 1);
+    sleep_us(5);
+  }
+  // STOP: SDA sobe com SCL em nível alto
+  gpio_put(scl, 0);
+  gpio_put(sda, 0);
+  gpio_set_dir(sda, GPIO_OUT);
+  sleep_us(5);
+  gpio_put(scl, 1);
+  sleep_us(5);
+  gpio_put(sda, 1);
+  sleep_us(5);
+
+  gpio_set_dir(sda, GPIO_IN);
+  gpio_set_dir(scl, GPIO_IN);
+  gpio_set_function(sda, GPIO_FUNC_I2C);
+  gpio_set_function(scl, GPIO_FUNC_I2C);
+}
+
+// Tenta voltar a falar com o painel: libera o barramento (se os pinos foram
+// informados), repete a configuração e agenda o envio da tela inteira.
+// Bloqueia no máximo o prazo das escritas de configuração; retorna false se
+// o painel continua sem responder.
+bool ssd1306_recover(ssd1306_t *ssd) {
+  if (ssd->sda_pin != SSD1306_NO_PIN && ssd->scl_pin != SSD1306_NO_PIN)
+    ssd1306_bus_clear(ssd);
+  ssd->online = true;
+  ssd1306_config(ssd);
+  if (!ssd->online)
+    return false;
+  ssd->i2c_recoveries++;
+  if (ssd->ram_buffer)
+    ssd1306_force_redraw(ssd);
+  return true;
+}
+
+// Atualiza o maior tempo bloqueado num envio síncrono
+static void ssd1306_note_flush_time(ssd1306_t *ssd, uint32_t start) {
+  uint32_t elapsed = time_us_32() - start;
+  if (elapsed > ssd->flush_max_us)
+    ssd->flush_max_us = elapsed;
+}
+
+void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  ssd->port_buffer[1] = command;
+  ssd1306_i2c_write(ssd, ssd->port_buffer, 2, false);
+}
+
+void ssd1306_cmdlist_init(ssd1306_cmdlist_t *list) {
+  list->buffer[0] = 0x00; // Co = 0, D/C# = 0: todos os bytes seguintes são comandos
+  list->len = 0;
+}
+
+bool ssd1306_cmdlist_add(ssd1306_cmdlist_t *list, uint8_t command) {
+  if (list->len >= SSD1306_CMDLIST_MAX)
+    return false;
+  list->buffer[1 + list->len++] = command;
+  return true;
+}
+
+// Envia a lista numa única transação. Com data_follows a transação não é
+// encerrada: o próximo envio de dados começa com um RESTART em vez de STOP/START.
+void ssd1306_cmdlist_send(ssd1306_t *ssd, const ssd1306_cmdlist_t *list, bool data_follows) {
+  if (list->len)
+    ssd1306_i2c_write(ssd, list->buffer, list->len + 1, data_follows);
+}
+
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  ssd1306_cmdlist_t list;
+  ssd1306_cmdlist_init(&list);
+  for (size_t i = 0; i < count; ++i) {
+    if (!ssd1306_cmdlist_add(&list, commands[i])) {
+      ssd1306_cmdlist_send(ssd, &list, false);
+      ssd1306_cmdlist_init(&list);
+      ssd1306_cmdlist_add(&list, commands[i]);
+    }
+  }
+  ssd1306_cmdlist_send(ssd, &list, false);
+}
+
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast) {
+  const uint8_t commands[] = { SET_CONTRAST, contrast };
+  ssd1306_command_list(ssd, commands, sizeof(commands));
+}
+
+// O painel exige a rolagem desligada antes de configurar uma nova
+void ssd1306_scroll_start(ssd1306_t *ssd, bool left, uint8_t page0, uint8_t page1, uint8_t speed, uint8_t vertical) {
+  if (ssd->scroll_pages)
+    ssd1306_scroll_stop(ssd);
+  ssd1306_cmdlist_t list;
+  ssd1306_cmdlist_init(&list);
+  ssd1306_cmdlist_add(&list, SET_SCROLL_OFF);
+  if (vertical) {
+    ssd1306_cmdlist_add(&list, left ? SET_SCROLL_VERT_LEFT : SET_SCROLL_VERT_RIGHT);
+    ssd1306_cmdlist_add(&list, 0x00);
+    ssd1306_cmdlist_add(&list, page0);
+    ssd1306_cmdlist_add(&list, speed);
+    ssd1306_cmdlist_add(&list, page1);
+    ssd1306_cmdlist_add(&list, vertical);
+  } else {
+    ssd1306_cmdlist_add(&list, left ? SET_SCROLL_LEFT : SET_SCROLL_RIGHT);
+    ssd1306_cmdlist_add(&list, 0x00);
+    ssd1306_cmdlist_add(&list, page0);
+    ssd1306_cmdlist_add(&list, speed);
+    ssd1306_cmdlist_add(&list, page1);
+    ssd1306_cmdlist_add(&list, 0x00);
+    ssd1306_cmdlist_add(&list, 0xFF);
+  }
+  ssd1306_cmdlist_add(&list, SET_SCROLL_ON);
+  ssd1306_cmdlist_send(ssd, &list, false);
+
+  // Com componente vertical a área inteira se move: nenhuma página recebe dados
+  if (vertical)
+    ssd->scroll_pages = (1 << SSD1306_PAGES(ssd)) - 1;
   else
-    ssd->ram_buffer[index] &= ~(1 << pixel);
+    ssd->scroll_pages = ((1 << (page1 + 1)) - 1) & ~((1 << page0) - 1);
+  ssd->hash_valid &= ~ssd->scroll_pages;
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
+void ssd1306_scroll_stop(ssd1306_t *ssd) {
+  ssd1306_command(ssd, SET_SCROLL_OFF);
+  uint8_t pages = ssd->scroll_pages;
+  ssd->scroll_pages = 0;
+  ssd->hash_valid &= ~pages;
+  uint8_t page0 = 0, page1;
+  while (ssd1306_next_page_run(pages, &page0, &page1)) {
+    ssd1306_mark_dirty(ssd, 0, page0, SSD1306_COLS(ssd) - 1, page1);
+    page0 = page1 + 1;
+  }
+}
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
+void ssd1306_scroll_area(ssd1306_t *ssd, uint8_t fixed_rows, uint8_t rows) {
+  const uint8_t commands[] = { SET_VSCROLL_AREA, fixed_rows, rows };
+  ssd1306_command_list(ssd, commands, sizeof(commands));
+}
+
+// Desloca o conteúdo da janela n colunas. Colunas vizinhas no mesmo
+// trecho contíguo (layout vertical com a altura toda, ou layout por
+// páginas) andam num único memmove por trecho; no layout vertical com só
+// parte das páginas cada coluna é um trecho e é copiada inteira. As n
+// colunas expostas ficam com lixo e devem ser redesenhadas; nada é marcado
+// sujo.
+void ssd1306_shift_columns(ssd1306_t *ssd, bool left, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1, uint8_t n) {
+  if (x1 <= x0 || n == 0 || n > x1 - x0)
+    return;
+  uint8_t *b = ssd->ram_buffer;
+  uint16_t cs = SSD1306_COL_STRIDE(ssd);
+  uint16_t shift = n * cs;
+  ssd1306_runs_t r = ssd1306_window_runs(ssd, x0, x1, page0, page1);
+  if (r.count == 1 || cs == 1) {
+    for (uint16_t i = 0, start = r.first; i < r.count; ++i, start += r.stride)
+      memmove(&b[start + (left ? 0 : shift)], &b[start + (left ? shift : 0)], r.len - shift);
+  } else if (left) {
+    for (uint16_t i = 0, start = r.first; i + n < r.count; ++i, start += r.stride)
+      memcpy(&b[start], &b[start + n * r.stride], r.len);
+  } else {
+    for (uint16_t i = r.count - 1, start = r.first + i * r.stride; i >= n; --i, start -= r.stride)
+      memcpy(&b[start], &b[start - n * r.stride], r.len);
+  }
+}
+
+// O deslocamento no framebuffer é rotativo, como no painel; a coluna exposta
+// é marcada suja de qualquer forma para que o envio seguinte a confirme
+void ssd1306_scroll_column(ssd1306_t *ssd, bool left, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+  if (x1 <= x0)
+    return;
+  const uint8_t commands[] = {
+    left ? SET_SCROLL_STEP_LEFT : SET_SCROLL_STEP_RIGHT, 0x00, page0, 0x00, page1, 0x00, x0, x1
+  };
+  ssd1306_command_list(ssd, commands, sizeof(commands));
+
+  uint8_t from = left ? x0 : x1, to = left ? x1 : x0;
+  uint8_t saved[SSD1306_MAX_PAGES];
+  for (uint8_t p = page0; p <= page1; ++p)
+    saved[p] = ssd->ram_buffer[ssd1306_index(ssd, from, p)];
+  ssd1306_shift_columns(ssd, left, x0, x1, page0, page1, 1);
+  for (uint8_t p = page0; p <= page1; ++p)
+    ssd->ram_buffer[ssd1306_index(ssd, to, p)] = saved[p];
+  ssd->hash_valid &= ~(((1 << (page1 + 1)) - 1) & ~((1 << page0) - 1));
+
+  // Bytes ainda não enviados dentro da região mudaram de lugar junto com ela
+  const ssd1306_window_t *d = &ssd->dirty_window;
+  if (ssd->dirty && d->x0 <= x1 && d->x1 >= x0 && d->page0 <= page1 && d->page1 >= page0)
+    ssd1306_mark_dirty(ssd, x0, page0, x1, page1);
+  else
+    ssd1306_mark_dirty(ssd, to, page0, to, page1);
+}
+
+// Define a janela de endereçamento (colunas x0..x1, páginas page0..page1) do
+// painel; os dados enviados em seguida reaproveitam a mesma transação
+void ssd1306_set_window(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+  ssd1306_cmdlist_t list;
+  ssd1306_cmdlist_init(&list);
+  ssd1306_cmdlist_add(&list, SET_COL_ADDR);
+  ssd1306_cmdlist_add(&list, x0);
+  ssd1306_cmdlist_add(&list, x1);
+  ssd1306_cmdlist_add(&list, SET_PAGE_ADDR);
+  ssd1306_cmdlist_add(&list, page0);
+  ssd1306_cmdlist_add(&list, page1);
+  ssd1306_cmdlist_send(ssd, &list, true);
+}
+
+// Envia len bytes de buffer a partir de start numa única transação.
+// O byte anterior é trocado temporariamente pelo prefixo de dados (0x40),
+// evitando copiar o trecho para outro buffer.
+static void ssd1306_write_run(ssd1306_t *ssd, uint8_t *buffer, uint16_t start, uint16_t len, bool last) {
+  uint8_t *run = &buffer[start - 1];
+  uint8_t saved = *run;
+  *run = 0x40;
+  ssd1306_i2c_write(ssd, run, len + 1, !last);
+  *run = saved;
+}
+
+static void ssd1306_window_merge(bool *valid, ssd1306_window_t *w, uint8_t x0, uint8_t page0, uint8_t x1, uint8_t page1) {
+  if (!*valid) {
+    *valid = true;
+    w->x0 = x0;
+    w->x1 = x1;
+    w->page0 = page0;
+    w->page1 = page1;
+    return;
+  }
+  if (x0 < w->x0) w->x0 = x0;
+  if (x1 > w->x1) w->x1 = x1;
+  if (page0 < w->page0) w->page0 = page0;
+  if (page1 > w->page1) w->page1 = page1;
+}
+
+// Envia len bytes prontos para a janela w. packet[0] é reservado para o
+// prefixo de dados e os bytes vão de packet[1] a packet[len], na ordem do
+// modo de endereçamento configurado. Os hashes dessas páginas deixam de
+// valer, já que o conteúdo não veio do framebuffer.
+void ssd1306_send_raw(ssd1306_t *ssd, const ssd1306_window_t *w, uint8_t *packet, uint16_t len) {
+  for (uint8_t p = w->page0; p <= w->page1; ++p)
+    ssd->hash_valid &= ~(1 << p);
+  ssd1306_set_window(ssd, w->x0, w->x1, w->page0, w->page1);
+  packet[0] = 0x40;
+  ssd1306_i2c_write(ssd, packet, len + 1, false);
+}
+
+// FNV-1a da página inteira, usado para saber se o painel já tem esse conteúdo
+static uint32_t ssd1306_page_hash(const ssd1306_t *ssd, const uint8_t *buffer, uint8_t page) {
+  uint32_t hash = 2166136261u;
+  const uint8_t *byte = &buffer[ssd1306_index(ssd, 0, page)];
+  for (uint8_t x = 0; x < SSD1306_COLS(ssd); ++x, byte += SSD1306_COL_STRIDE(ssd)) {
+    hash ^= *byte;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Envia o quadro inteiro
+void ssd1306_send_data(ssd1306_t *ssd) {
+  uint8_t *buffer = ssd->ram_buffer;
+  uint32_t t0 = time_us_32();
+  ssd1306_set_window(ssd, 0, SSD1306_COLS(ssd) - 1, 0, SSD1306_PAGES(ssd) - 1);
+  ssd1306_write_run(ssd, buffer, 1, ssd->bufsize - 1, true);
+  ssd1306_note_flush_time(ssd, t0);
+  if (ssd->online) {
+    for (uint8_t p = 0; p < SSD1306_PAGES(ssd); ++p)
+      ssd->page_hash[p] = ssd1306_page_hash(ssd, buffer, p);
+    ssd->hash_valid = (1 << SSD1306_PAGES(ssd)) - 1;
+    ssd->bytes_sent += ssd->bufsize - 1;
+  }
+  ssd->dirty = false;
+}
+
+// Retira a janela pendente de envio e o buffer de onde ela deve ser lida.
+// Páginas cujo hash é igual ao do último conteúdo enviado ao painel são
+// descartadas; pages recebe a máscara das páginas que ainda precisam ir.
+// Offline nada é retirado: a janela fica pendente até a recuperação.
+bool ssd1306_take_flush(ssd1306_t *ssd, const uint8_t **buffer, ssd1306_window_t *window, uint8_t *pages) {
+  if (!ssd->online)
+    return false;
+  if (!ssd->dirty)
+    return false;
+  *buffer = ssd->ram_buffer;
+  *window = ssd->dirty_window;
+  ssd->dirty = false;
+
+  uint16_t cols = window->x1 - window->x0 + 1;
+  bool full_width = cols == SSD1306_COLS(ssd);
+  uint8_t mask = 0;
+  for (uint8_t p = window->page0; p <= window->page1; ++p) {
+    if (ssd->scroll_pages & (1 << p))
+      continue;
+    uint32_t hash = ssd1306_page_hash(ssd, *buffer, p);
+    if ((ssd->hash_valid & (1 << p)) && hash == ssd->page_hash[p]) {
+      ssd->bytes_skipped += cols;
+      continue;
     }
+    mask |= 1 << p;
+    ssd->bytes_sent += cols;
+    // O hash só representa o painel se a página já foi enviada inteira uma vez;
+    // daí em diante o rastreamento sujo mantém o resto da página em dia
+    if (full_width)
+      ssd->hash_valid |= 1 << p;
+    ssd->page_hash[p] = hash;
+  }
+  if (!mask)
+    return false;
+
+  while (!(mask & (1 << window->page0)))
+    ++window->page0;
+  while (!(mask & (1 << window->page1)))
+    --window->page1;
+  *pages = mask;
+  return true;
 }
 
+// Força o próximo envio a transmitir a tela inteira, mesmo sem mudanças
+void ssd1306_force_redraw(ssd1306_t *ssd) {
+  ssd->hash_valid = 0;
+  ssd1306_mark_dirty(ssd, 0, 0, SSD1306_COLS(ssd) - 1, SSD1306_PAGES(ssd) - 1);
+}
 
+// Envia apenas a janela alterada desde o último envio, uma janela por
+// sequência de páginas alteradas. Cada janela sai como os trechos contíguos
+// do buffer que a compõem, um por transação de dados.
+void ssd1306_send_dirty(ssd1306_t *ssd) {
+  const uint8_t *source;
+  ssd1306_window_t w;
+  uint8_t pages;
+  if (!ssd1306_take_flush(ssd, &source, &w, &pages))
+    return;
 
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
+  uint8_t *buffer = (uint8_t *)source;
+  uint32_t t0 = time_us_32();
+  uint8_t page0 = w.page0, page1;
+  while (ssd1306_next_page_run(pages, &page0, &page1)) {
+    bool last_run = (pages >> (page1 + 1)) == 0;
+    ssd1306_runs_t r = ssd1306_window_runs(ssd, w.x0, w.x1, page0, page1);
+    ssd1306_set_window(ssd, w.x0, w.x1, page0, page1);
+    for (uint16_t i = 0, start = r.first; i < r.count; ++i, start += r.stride)
+      ssd1306_write_run(ssd, buffer, start, r.len, last_run && i + 1 == r.count);
+    page0 = page1 + 1;
   }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
+  ssd1306_note_flush_time(ssd, t0);
+}
+
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t page0, uint8_t x1, uint8_t page1) {
+  ssd1306_window_merge(&ssd->dirty, &ssd->dirty_window, x0, page0, x1, page1);
+}
+
+// Grava os bits de um byte do ram_buffer selecionados pela máscara
+static inline void ssd1306_put_bits(ssd1306_t *ssd, uint8_t x, uint8_t page, uint8_t bits, uint8_t mask) {
+  uint8_t *byte = &ssd->ram_buffer[ssd1306_index(ssd, x, page)];
+  uint8_t value = (*byte & ~mask) | (bits & mask);
+  if (value != *byte) {
+    *byte = value;
+    ssd1306_mark_dirty(ssd, x, page, x, page);
   }
+}
 
-  if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
+#ifndef SSD1306_FIXED_GEOMETRY
+void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  ssd1306_pixel_inline(ssd, x, y, value);
+}
+#endif
+
+// Preenche len bytes com o mesmo valor. O memset da biblioteca já usa
+// escritas de palavra onde o endereço permite, sem acessar o buffer de
+// uint8_t por outro tipo. Retorna true se algum byte mudou.
+static bool ssd1306_fill_bytes(uint8_t *dst, uint16_t len, uint8_t value) {
+  uint16_t i = 0;
+  while (i < len && dst[i] == value)
+    ++i;
+  if (i == len)
+    return false;
+  memset(&dst[i], value, len - i);
+  return true;
+}
+
+// Aplica bits/máscara à mesma página de todas as colunas x0..x1
+static bool ssd1306_mask_span(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page, uint8_t bits, uint8_t mask) {
+  uint8_t *byte = &ssd->ram_buffer[ssd1306_index(ssd, x0, page)];
+  uint8_t diff = 0;
+  for (uint16_t x = x0; x <= x1; ++x, byte += SSD1306_COL_STRIDE(ssd)) {
+    uint8_t value = (*byte & ~mask) | (bits & mask);
+    diff |= *byte ^ value;
+    *byte = value;
+  }
+  return diff != 0;
+}
+
+// Núcleo de spans usado por todas as primitivas retangulares: recorta o
+// retângulo [x0,x1] x [y0,y1] à tela, calcula uma vez as máscaras da primeira
+// e da última página e preenche as páginas inteiras trecho a trecho com
+// memset (a área inteira vira um trecho só quando cobre todas as páginas no
+// layout vertical ou todas as colunas no layout por página).
+static void ssd1306_fill_area(ssd1306_t *ssd, int x0, int y0, int x1, int y1, bool value) {
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 >= SSD1306_COLS(ssd)) x1 = SSD1306_COLS(ssd) - 1;
+  if (y1 >= SSD1306_ROWS(ssd)) y1 = SSD1306_ROWS(ssd) - 1;
+  if (x0 > x1 || y0 > y1)
+    return;
+
+  uint8_t bits = value ? 0xFF : 0x00;
+  uint8_t page0 = y0 >> 3, page1 = y1 >> 3;
+  uint8_t top = 0xFF << (y0 & 0b111);
+  uint8_t bottom = 0xFF >> (7 - (y1 & 0b111));
+  bool changed = false;
+
+  if (page0 == page1) {
+    changed = ssd1306_mask_span(ssd, x0, x1, page0, bits, top & bottom);
+  } else {
+    // Páginas parciais nas bordas; as demais são preenchidas inteiras
+    uint8_t full0 = page0, full1 = page1;
+    if (top != 0xFF)
+      changed |= ssd1306_mask_span(ssd, x0, x1, full0++, bits, top);
+    if (bottom != 0xFF)
+      changed |= ssd1306_mask_span(ssd, x0, x1, full1--, bits, bottom);
+
+    if (full0 <= full1) {
+      ssd1306_runs_t r = ssd1306_window_runs(ssd, x0, x1, full0, full1);
+      for (uint16_t i = 0, start = r.first; i < r.count; ++i, start += r.stride)
+        changed |= ssd1306_fill_bytes(&ssd->ram_buffer[start], r.len, bits);
     }
   }
+
+  if (changed)
+    ssd1306_mark_dirty(ssd, x0, page0, x1, page1);
+}
+
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  ssd1306_fill_area(ssd, 0, 0, SSD1306_COLS(ssd) - 1, SSD1306_ROWS(ssd) - 1, value);
+}
+
+void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  if (width == 0 || height == 0)
+    return;
+
+  int right = left + width - 1;
+  int bottom = top + height - 1;
+  if (fill) {
+    ssd1306_fill_area(ssd, left, top, right, bottom, value);
+    return;
+  }
+  ssd1306_fill_area(ssd, left, top, right, top, value);
+  ssd1306_fill_area(ssd, left, bottom, right, bottom, value);
+  ssd1306_fill_area(ssd, left, top, left, bottom, value);
+  ssd1306_fill_area(ssd, right, top, right, bottom, value);
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
@@ -144,13 +608,11 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 
 
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  ssd1306_fill_area(ssd, x0, y, x1, y, value);
 }
 
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+  ssd1306_fill_area(ssd, x, y0, x, y1, value);
 }
 
 // Função para desenhar um caractere
@@ -169,30 +631,75 @@ void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
     index = 0; // Índice 0 corresponde ao caractere "nada" (espaço)
   }
 
-  // Desenha o caractere na tela
-  for (uint8_t i = 0; i < 8; ++i)
+  // Cada byte da fonte é uma coluna do glifo no mesmo formato de página do
+  // SSD1306 (bit 0 no topo)
+  ssd1306_draw_bitmap(ssd, &font[index], x, y, 8, 1);
+}
+
+// Desenha um bitmap de w colunas por pages páginas (8 linhas cada), no
+// formato de página do SSD1306: bitmap[p * w + i] é a coluna i da página p,
+// bit 0 no topo. Com y múltiplo de 8 cada byte é copiado direto; caso
+// contrário ele é dividido entre duas páginas com deslocamento e máscara.
+void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap, uint8_t x, uint8_t y, uint8_t w, uint8_t pages)
+{
+  uint8_t shift = y & 0b111;
+  if (!shift)
+  {
+    // Alinhado à página: cópia byte a byte, marcando a área suja uma vez só
+    uint8_t page0 = y >> 3;
+    if (x >= SSD1306_COLS(ssd) || page0 >= SSD1306_PAGES(ssd))
+      return;
+    uint8_t cols = x + w > SSD1306_COLS(ssd) ? SSD1306_COLS(ssd) - x : w;
+    uint8_t rows = page0 + pages > SSD1306_PAGES(ssd) ? SSD1306_PAGES(ssd) - page0 : pages;
+    uint8_t diff = 0;
+    for (uint8_t p = 0; p < rows; ++p)
+    {
+      const uint8_t *src = &bitmap[p * w];
+      uint8_t *byte = &ssd->ram_buffer[ssd1306_index(ssd, x, page0 + p)];
+      for (uint8_t i = 0; i < cols; ++i, byte += SSD1306_COL_STRIDE(ssd))
+      {
+        diff |= *byte ^ src[i];
+        *byte = src[i];
+      }
+    }
+    if (diff)
+      ssd1306_mark_dirty(ssd, x, page0, x + cols - 1, page0 + rows - 1);
+    return;
+  }
+
+  for (uint8_t p = 0; p < pages; ++p)
   {
-    uint8_t line = font[index + i]; // Acessa a linha correspondente do caractere na fonte
-    for (uint8_t j = 0; j < 8; ++j)
+    uint16_t page = (y >> 3) + p;
+    if (page >= SSD1306_PAGES(ssd))
+      break; // Recorte na borda inferior
+    const uint8_t *row = &bitmap[p * w];
+    for (uint8_t i = 0; i < w; ++i)
     {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j)); // Desenha cada pixel do caractere
+      uint16_t col = x + i;
+      if (col >= SSD1306_COLS(ssd))
+        break; // Recorte na borda direita
+      uint8_t line = row[i];
+      ssd1306_put_bits(ssd, col, page, line << shift, 0xFF << shift);
+      if (shift && page + 1 < SSD1306_PAGES(ssd))
+        ssd1306_put_bits(ssd, col, page + 1, line >> (8 - shift), 0xFF >> (8 - shift));
     }
   }
 }
 
 // Função para desenhar uma string
+// O texto é UTF-8: cada código ocupa uma célula de 8 colunas
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
 {
   while (*str)
   {
-    ssd1306_draw_char(ssd, *str++, x, y);
+    ssd1306_draw_char(ssd, ssd1306_ascii(ssd1306_utf8_next(&str)), x, y);
     x += 8;
-    if (x + 8 >= ssd->width)
+    if (x + 8 >= SSD1306_COLS(ssd))
     {
       x = 0;
       y += 8;
     }
-    if (y + 8 >= ssd->height)
+    if (y + 8 >= SSD1306_ROWS(ssd))
     {
       break;
     }
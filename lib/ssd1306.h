@@ -1,3 +1,6 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
@@ -5,6 +8,37 @@
 #define WIDTH 128
 #define HEIGHT 64
 
+// Com SSD1306_FIXED_GEOMETRY o driver assume um painel WIDTH x HEIGHT: o
+// framebuffer vira um array estático (.bss) em vez de calloc() no heap e os
+// passos usados nos laços de desenho viram constantes de compilação.
+// SSD1306_STATIC_BUFFERS define quantos painéis podem ser inicializados.
+#ifdef SSD1306_FIXED_GEOMETRY
+#ifndef SSD1306_STATIC_BUFFERS
+#define SSD1306_STATIC_BUFFERS 1
+#endif
+#define SSD1306_COLS(ssd) WIDTH
+#define SSD1306_ROWS(ssd) HEIGHT
+#define SSD1306_PAGES(ssd) (HEIGHT / 8)
+#else
+#define SSD1306_COLS(ssd) ((ssd)->width)
+#define SSD1306_ROWS(ssd) ((ssd)->height)
+#define SSD1306_PAGES(ssd) ((ssd)->pages)
+#endif
+
+// Layout do framebuffer. O padrão segue o endereçamento vertical do SSD1306
+// (as páginas de uma coluna são contíguas). Com SSD1306_PAGE_MAJOR o driver
+// usa o endereçamento horizontal: cada página (uma linha de texto de 8 px) é
+// um trecho contíguo de COLS bytes.
+#ifdef SSD1306_PAGE_MAJOR
+#define SSD1306_MEM_ADDR_MODE 0x00
+#define SSD1306_COL_STRIDE(ssd) 1
+#define SSD1306_PAGE_STRIDE(ssd) SSD1306_COLS(ssd)
+#else
+#define SSD1306_MEM_ADDR_MODE 0x01
+#define SSD1306_COL_STRIDE(ssd) SSD1306_PAGES(ssd)
+#define SSD1306_PAGE_STRIDE(ssd) 1
+#endif
+
 typedef enum {
   SET_CONTRAST = 0x81,
   SET_ENTIRE_ON = 0xA4,
@@ -22,9 +56,60 @@ typedef enum {
   SET_DISP_CLK_DIV = 0xD5,
   SET_PRECHARGE = 0xD9,
   SET_VCOM_DESEL = 0xDB,
-  SET_CHARGE_PUMP = 0x8D
+  SET_CHARGE_PUMP = 0x8D,
+  SET_SCROLL_RIGHT = 0x26,      // Rolagem horizontal contínua
+  SET_SCROLL_LEFT = 0x27,
+  SET_SCROLL_VERT_RIGHT = 0x29, // Horizontal mais vertical
+  SET_SCROLL_VERT_LEFT = 0x2A,
+  SET_SCROLL_STEP_RIGHT = 0x2C, // Desloca o conteúdo uma coluna
+  SET_SCROLL_STEP_LEFT = 0x2D,
+  SET_SCROLL_OFF = 0x2E,
+  SET_SCROLL_ON = 0x2F,
+  SET_VSCROLL_AREA = 0xA3
 } ssd1306_command_t;
 
+// Intervalo entre passos da rolagem contínua, em quadros do painel
+typedef enum {
+  SSD1306_SCROLL_2_FRAMES = 0x07,
+  SSD1306_SCROLL_3_FRAMES = 0x04,
+  SSD1306_SCROLL_4_FRAMES = 0x05,
+  SSD1306_SCROLL_5_FRAMES = 0x00,
+  SSD1306_SCROLL_25_FRAMES = 0x06,
+  SSD1306_SCROLL_64_FRAMES = 0x01,
+  SSD1306_SCROLL_128_FRAMES = 0x02,
+  SSD1306_SCROLL_256_FRAMES = 0x03
+} ssd1306_scroll_speed_t;
+
+// Máximo de comandos numa transação montada por ssd1306_cmdlist_t
+#define SSD1306_CMDLIST_MAX 32
+
+// Prazo de cada escrita no barramento: um valor fixo mais o tempo de um
+// byte a 400 kHz (9 bits = 22,5 us) com folga. Uma escrita nunca bloqueia
+// além de SSD1306_I2C_TIMEOUT_US + len * SSD1306_I2C_BYTE_US.
+#ifndef SSD1306_I2C_TIMEOUT_US
+#define SSD1306_I2C_TIMEOUT_US 500
+#endif
+#ifndef SSD1306_I2C_BYTE_US
+#define SSD1306_I2C_BYTE_US 30
+#endif
+
+// Pino ainda não informado para a recuperação do barramento
+#define SSD1306_NO_PIN 0xFF
+
+// Maior número de páginas suportado (painel de 64 linhas)
+#define SSD1306_MAX_PAGES 8
+
+// Lista de comandos enviada numa única transação com prefixo 0x00
+typedef struct {
+  uint8_t buffer[SSD1306_CMDLIST_MAX + 1];
+  uint8_t len;
+} ssd1306_cmdlist_t;
+
+// Janela retangular em colunas (x0..x1) e páginas (page0..page1), inclusiva
+typedef struct {
+  uint8_t x0, x1, page0, page1;
+} ssd1306_window_t;
+
 typedef struct {
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
@@ -32,18 +117,180 @@ typedef struct {
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
+  // Janela suja: colunas/páginas alteradas desde o último envio ao painel
+  bool dirty;
+  ssd1306_window_t dirty_window;
+  // Contadores do barramento: transações (START + endereço) e bytes enviados
+  uint32_t i2c_transactions;
+  uint32_t i2c_bytes;
+  // Hash de cada página como o painel a recebeu por último (válido se o bit
+  // correspondente de hash_valid estiver ligado) e bytes do framebuffer
+  // enviados ou descartados por não terem mudado
+  uint32_t page_hash[SSD1306_MAX_PAGES];
+  uint8_t hash_valid;
+  uint32_t bytes_sent;
+  uint32_t bytes_skipped;
+  // Falha de barramento: depois de um NACK ou prazo estourado o driver fica
+  // offline e descarta as escritas (sem bloquear) até ssd1306_recover()
+  volatile bool online;
+  uint8_t sda_pin, scl_pin;
+  volatile uint32_t i2c_errors;
+  uint32_t i2c_recoveries;
+  uint32_t flush_max_us; // Maior tempo bloqueado num envio síncrono
+  // Páginas em rolagem contínua: o painel move o conteúdo sozinho e não pode
+  // receber dados nelas, então os envios as pulam até ssd1306_scroll_stop()
+  uint8_t scroll_pages;
 } ssd1306_t;
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+// Posição no ram_buffer do byte da coluna x na página page, conforme o
+// layout escolhido. O índice 0 guarda o prefixo de dados 0x40.
+static inline uint16_t ssd1306_index(const ssd1306_t *ssd, uint8_t x, uint8_t page) {
+  (void) ssd; // Com SSD1306_FIXED_GEOMETRY os passos são constantes
+  return 1 + x * SSD1306_COL_STRIDE(ssd) + page * SSD1306_PAGE_STRIDE(ssd);
+}
+
+// Uma janela decomposta em trechos contíguos do buffer, na ordem em que o
+// painel espera os bytes: count trechos de len bytes, o primeiro em first e
+// os seguintes a cada stride bytes. Quando os trechos se encostam a janela
+// vira um trecho só.
+typedef struct {
+  uint16_t first, stride, len, count;
+} ssd1306_runs_t;
+
+static inline ssd1306_runs_t ssd1306_window_runs(const ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+  ssd1306_runs_t r;
+  r.first = ssd1306_index(ssd, x0, page0);
+#ifdef SSD1306_PAGE_MAJOR
+  r.len = x1 - x0 + 1;
+  r.count = page1 - page0 + 1;
+  r.stride = SSD1306_COLS(ssd);
+#else
+  r.len = page1 - page0 + 1;
+  r.count = x1 - x0 + 1;
+  r.stride = SSD1306_PAGES(ssd);
+#endif
+  if (r.len == r.stride) {
+    r.len *= r.count;
+    r.count = 1;
+  }
+  return r;
+}
+
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t page0, uint8_t x1, uint8_t page1);
+
+// Próxima sequência contígua de páginas marcadas em mask a partir de *page0
+static inline bool ssd1306_next_page_run(uint8_t mask, uint8_t *page0, uint8_t *page1) {
+  uint8_t p = *page0;
+  while (p < SSD1306_MAX_PAGES && !(mask & (1 << p)))
+    ++p;
+  if (p >= SSD1306_MAX_PAGES)
+    return false;
+  *page0 = p;
+  while (p + 1 < SSD1306_MAX_PAGES && (mask & (1 << (p + 1))))
+    ++p;
+  *page1 = p;
+  return true;
+}
+
+static inline void ssd1306_pixel_inline(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  uint8_t *byte = &ssd->ram_buffer[ssd1306_index(ssd, x, y >> 3)];
+  uint8_t old = *byte;
+  if (value)
+    *byte |= (1 << (y & 0b111));
+  else
+    *byte &= ~(1 << (y & 0b111));
+  // Só marca a região como suja se o byte realmente mudou
+  if (*byte != old)
+    ssd1306_mark_dirty(ssd, x, y >> 3, x, y >> 3);
+}
+
+// Decodifica o próximo código UTF-8 de *text e avança o ponteiro. Bytes
+// que não formam uma sequência válida (continuação solta, forma longa,
+// surrogate, sequência cortada) viram SSD1306_UTF8_INVALID e consomem um
+// byte só, sem nunca passar do '\0'.
+#define SSD1306_UTF8_INVALID 0xFFFD
+
+static inline uint32_t ssd1306_utf8_next(const char **text) {
+  const uint8_t *s = (const uint8_t *)*text;
+  uint32_t code = s[0];
+  uint8_t len;
+  *text += 1;
+  if (code < 0x80)
+    return code;
+  if (code >= 0xC2 && code <= 0xDF) {
+    len = 2;
+    code &= 0x1F;
+  } else if (code >= 0xE0 && code <= 0xEF) {
+    len = 3;
+    code &= 0x0F;
+  } else if (code >= 0xF0 && code <= 0xF4) {
+    len = 4;
+    code &= 0x07;
+  } else {
+    return SSD1306_UTF8_INVALID;
+  }
+  for (uint8_t i = 1; i < len; ++i) {
+    if ((s[i] & 0xC0) != 0x80)
+      return SSD1306_UTF8_INVALID;
+    code = (code << 6) | (s[i] & 0x3F);
+  }
+  if ((len == 3 && (code < 0x800 || (code >= 0xD800 && code <= 0xDFFF))) ||
+      (len == 4 && (code < 0x10000 || code > 0x10FFFF)))
+    return SSD1306_UTF8_INVALID;
+  *text = (const char *)s + len;
+  return code;
+}
+
+// A fonte 8x8 só tem ASCII; os demais códigos aparecem como '?'
+static inline char ssd1306_ascii(uint32_t code) {
+  return code < 0x80 ? (char)code : '?';
+}
+
+bool ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+void ssd1306_init_bus(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
+void ssd1306_set_bus_pins(ssd1306_t *ssd, uint8_t sda, uint8_t scl);
+void ssd1306_i2c_fault(ssd1306_t *ssd);
+bool ssd1306_recover(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count);
+void ssd1306_cmdlist_init(ssd1306_cmdlist_t *list);
+bool ssd1306_cmdlist_add(ssd1306_cmdlist_t *list, uint8_t command);
+void ssd1306_cmdlist_send(ssd1306_t *ssd, const ssd1306_cmdlist_t *list, bool data_follows);
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_send_dirty(ssd1306_t *ssd);
+void ssd1306_set_window(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1);
+void ssd1306_send_raw(ssd1306_t *ssd, const ssd1306_window_t *w, uint8_t *packet, uint16_t len);
+bool ssd1306_take_flush(ssd1306_t *ssd, const uint8_t **buffer, ssd1306_window_t *window, uint8_t *pages);
+void ssd1306_force_redraw(ssd1306_t *ssd);
 
+// Rolagem em hardware. A contínua roda sem tráfego no barramento, sempre na
+// largura toda das páginas; vertical > 0 soma esse número de linhas por
+// passo dentro da área de ssd1306_scroll_area(). Parar a rolagem reenvia as
+// páginas, pois o painel as deixa deslocadas. ssd1306_scroll_column() move
+// uma coluna por comando e desloca junto o framebuffer; a coluna exposta
+// fica suja para ser preenchida pelo envio seguinte.
+void ssd1306_scroll_start(ssd1306_t *ssd, bool left, uint8_t page0, uint8_t page1, uint8_t speed, uint8_t vertical);
+void ssd1306_scroll_stop(ssd1306_t *ssd);
+void ssd1306_scroll_area(ssd1306_t *ssd, uint8_t fixed_rows, uint8_t rows);
+void ssd1306_scroll_column(ssd1306_t *ssd, bool left, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1);
+
+// Só no framebuffer: desloca a janela n colunas, sem marcar nada sujo
+void ssd1306_shift_columns(ssd1306_t *ssd, bool left, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1, uint8_t n);
+
+#ifdef SSD1306_FIXED_GEOMETRY
+#define ssd1306_pixel ssd1306_pixel_inline
+#else
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
+#endif
 void ssd1306_fill(ssd1306_t *ssd, bool value);
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
+void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap, uint8_t x, uint8_t y, uint8_t w, uint8_t pages);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+
+#endif
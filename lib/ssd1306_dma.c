@@ -0,0 +1,176 @@
+#include "lib/ssd1306_dma.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+// Prefixo de comandos (0x00 + 6 bytes de janela) + prefixo de dados (0x40),
+// repetido para cada sequência de páginas (no máximo uma a cada duas páginas)
+#define SSD1306_DMA_HEADER 8
+#define SSD1306_DMA_RUNS ((SSD1306_MAX_PAGES + 1) / 2)
+
+// Envio mais recente de cada controlador I2C, que recebe as interrupções;
+// vários painéis podem dividir o controlador, um envio de cada vez
+static ssd1306_dma_t *dma_ativo[2];
+
+static void ssd1306_dma_finish(ssd1306_dma_t *dma, bool ok) {
+  if (!ok)
+    ssd1306_i2c_fault(dma->ssd);
+  dma->last_ok = ok;
+  dma->state = SSD1306_FLUSH_IDLE;
+  if (dma->callback)
+    dma->callback(dma, ok, dma->callback_arg);
+}
+
+static void ssd1306_dma_irq(uint index) {
+  ssd1306_dma_t *dma = dma_ativo[index];
+  i2c_hw_t *hw = i2c_get_hw(i2c_get_instance(index));
+  uint32_t status = hw->intr_stat;
+
+  if (status & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+    // NACK ou perda de arbitragem: o controlador descarta o FIFO enquanto o
+    // abort não é limpo. O canal DMA e o pedido de DMA param antes disso,
+    // como em ssd1306_flush_abort(); limpar primeiro deixaria o resto do
+    // buffer entrar no FIFO como uma transação nova, começando nos dados.
+    bool busy = dma && dma->state == SSD1306_FLUSH_BUSY;
+    hw->intr_mask = 0;
+    if (busy)
+      dma_channel_abort(dma->channel);
+    hw->dma_cr = 0;
+    (void) hw->clr_tx_abrt;
+    if (busy)
+      ssd1306_dma_finish(dma, false);
+  }
+  if (status & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+    (void) hw->clr_stop_det;
+    hw->intr_mask = 0;
+    if (dma && dma->state == SSD1306_FLUSH_BUSY)
+      ssd1306_dma_finish(dma, true);
+  }
+}
+
+static void ssd1306_dma_irq0(void) { ssd1306_dma_irq(0); }
+static void ssd1306_dma_irq1(void) { ssd1306_dma_irq(1); }
+
+bool ssd1306_dma_init(ssd1306_dma_t *dma, ssd1306_t *ssd) {
+  uint index = i2c_hw_index(ssd->i2c_port);
+
+  dma->ssd = ssd;
+  dma->state = SSD1306_FLUSH_IDLE;
+  dma->last_ok = true;
+  dma->callback = NULL;
+  dma->callback_arg = NULL;
+  dma->cmd_buffer = calloc(SSD1306_DMA_HEADER * SSD1306_DMA_RUNS + ssd->bufsize - 1, sizeof(uint16_t));
+  if (!dma->cmd_buffer)
+    return false;
+  dma->channel = dma_claim_unused_channel(false);
+  if (dma->channel < 0) {
+    free(dma->cmd_buffer);
+    dma->cmd_buffer = NULL;
+    return false;
+  }
+
+  dma_channel_config c = dma_channel_get_default_config(dma->channel);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, i2c_get_dreq(ssd->i2c_port, true));
+  dma_channel_configure(dma->channel, &c, &i2c_get_hw(ssd->i2c_port)->data_cmd, dma->cmd_buffer, 0, false);
+
+  uint irq = index ? I2C1_IRQ : I2C0_IRQ;
+  irq_set_exclusive_handler(irq, index ? ssd1306_dma_irq1 : ssd1306_dma_irq0);
+  irq_set_enabled(irq, true);
+  return true;
+}
+
+// Monta a transação: para cada sequência de páginas alteradas, comandos da
+// janela e dados, separados por RESTART; STOP só no último byte
+static size_t ssd1306_dma_build(ssd1306_dma_t *dma, const uint8_t *buffer, const ssd1306_window_t *w, uint8_t pages) {
+  ssd1306_t *ssd = dma->ssd;
+  uint16_t *out = dma->cmd_buffer;
+  uint8_t page0 = w->page0, page1;
+
+  while (ssd1306_next_page_run(pages, &page0, &page1)) {
+    uint16_t restart = out == dma->cmd_buffer ? 0 : I2C_IC_DATA_CMD_RESTART_BITS;
+    *out++ = 0x00 | restart;
+    *out++ = SET_COL_ADDR;
+    *out++ = w->x0;
+    *out++ = w->x1;
+    *out++ = SET_PAGE_ADDR;
+    *out++ = page0;
+    *out++ = page1;
+    *out++ = 0x40 | I2C_IC_DATA_CMD_RESTART_BITS;
+    ssd1306_runs_t r = ssd1306_window_runs(ssd, w->x0, w->x1, page0, page1);
+    for (uint16_t i = 0, start = r.first; i < r.count; ++i, start += r.stride) {
+      const uint8_t *run = &buffer[start];
+      for (uint16_t j = 0; j < r.len; ++j)
+        *out++ = run[j];
+    }
+    // Comandos e dados, cada um com seu byte de endereço
+    ssd->i2c_transactions += 2;
+    ssd->i2c_bytes += 2;
+    page0 = page1 + 1;
+  }
+  out[-1] |= I2C_IC_DATA_CMD_STOP_BITS;
+  return out - dma->cmd_buffer;
+}
+
+// Inicia o envio da janela suja. Retorna false se não há nada a enviar ou se
+// um envio anterior ainda está em andamento; nesse caso o callback não é chamado.
+bool ssd1306_flush_async(ssd1306_dma_t *dma, ssd1306_flush_cb_t callback, void *arg) {
+  ssd1306_t *ssd = dma->ssd;
+  const uint8_t *buffer;
+  ssd1306_window_t window;
+  uint8_t pages;
+  uint index = i2c_hw_index(ssd->i2c_port);
+  ssd1306_dma_t *ativo = dma_ativo[index];
+  if (dma->state != SSD1306_FLUSH_IDLE || (ativo && ativo->state == SSD1306_FLUSH_BUSY))
+    return false;
+  if (!ssd1306_take_flush(ssd, &buffer, &window, &pages))
+    return false;
+  dma_ativo[index] = dma;
+
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  dma->callback = callback;
+  dma->callback_arg = arg;
+  dma->cmd_len = ssd1306_dma_build(dma, buffer, &window, pages);
+  ssd->i2c_bytes += dma->cmd_len;
+  dma->state = SSD1306_FLUSH_BUSY;
+
+  // Endereço de destino só pode ser trocado com o controlador desabilitado
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = 1;
+  (void) hw->clr_stop_det;
+  (void) hw->clr_tx_abrt;
+  hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+  hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS;
+
+  dma_channel_transfer_from_buffer_now(dma->channel, dma->cmd_buffer, dma->cmd_len);
+  return true;
+}
+
+// Cancela um envio que não terminou no prazo (barramento travado, sem
+// STOP_DET nem TX_ABRT). Conta como falha, mas o callback não é chamado:
+// quem cancela já sabe que o envio acabou.
+void ssd1306_flush_abort(ssd1306_dma_t *dma) {
+  i2c_hw_t *hw = i2c_get_hw(dma->ssd->i2c_port);
+  hw->intr_mask = 0;
+  if (dma->state != SSD1306_FLUSH_BUSY)
+    return;
+  dma_channel_abort(dma->channel);
+  hw->dma_cr = 0;
+  hw->enable = 0; // Descarta o que restou no FIFO de TX
+  ssd1306_i2c_fault(dma->ssd);
+  dma->last_ok = false;
+  dma->state = SSD1306_FLUSH_IDLE;
+}
+
+bool ssd1306_flush_busy(ssd1306_dma_t *dma) {
+  return dma->state == SSD1306_FLUSH_BUSY;
+}
+
+// Espera ativa pelo fim do envio; prefira o callback em tarefas do FreeRTOS
+bool ssd1306_flush_wait(ssd1306_dma_t *dma) {
+  while (dma->state == SSD1306_FLUSH_BUSY)
+    tight_loop_contents();
+  return dma->last_ok;
+}
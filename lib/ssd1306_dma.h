@@ -0,0 +1,47 @@
+#ifndef SSD1306_DMA_H
+#define SSD1306_DMA_H
+
+#include "lib/ssd1306.h"
+
+// Envio assíncrono do framebuffer: a janela suja é copiada para um buffer de
+// comandos de 16 bits (formato do registrador IC_DATA_CMD) e um canal DMA
+// alimenta o FIFO de TX do I2C. O fim é detectado pela interrupção STOP_DET
+// (ou TX_ABRT em caso de NACK, que deixa o ssd offline) do controlador I2C.
+//
+// Cada painel tem o seu ssd1306_dma_t (e o seu canal DMA). Painéis em
+// controladores I2C diferentes enviam em paralelo; no mesmo controlador
+// ssd1306_flush_async() recusa o envio (retorna false, sem consumir a
+// janela suja) enquanto o de outro painel não termina.
+//
+// Enquanto um envio está em andamento não use ssd1306_command() nem
+// ssd1306_send_data() no mesmo barramento. O ram_buffer pode ser alterado
+// livremente assim que ssd1306_flush_async() retorna.
+
+typedef struct ssd1306_dma ssd1306_dma_t;
+
+// Chamado no contexto da interrupção do I2C ao final do envio
+typedef void (*ssd1306_flush_cb_t)(ssd1306_dma_t *dma, bool ok, void *arg);
+
+typedef enum {
+  SSD1306_FLUSH_IDLE,
+  SSD1306_FLUSH_BUSY
+} ssd1306_flush_state_t;
+
+struct ssd1306_dma {
+  ssd1306_t *ssd;
+  int channel;
+  uint16_t *cmd_buffer;
+  size_t cmd_len;
+  volatile ssd1306_flush_state_t state;
+  volatile bool last_ok;
+  ssd1306_flush_cb_t callback;
+  void *callback_arg;
+};
+
+bool ssd1306_dma_init(ssd1306_dma_t *dma, ssd1306_t *ssd);
+bool ssd1306_flush_async(ssd1306_dma_t *dma, ssd1306_flush_cb_t callback, void *arg);
+void ssd1306_flush_abort(ssd1306_dma_t *dma);
+bool ssd1306_flush_busy(ssd1306_dma_t *dma);
+bool ssd1306_flush_wait(ssd1306_dma_t *dma);
+
+#endif
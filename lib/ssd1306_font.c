@@ -0,0 +1,54 @@
+#include "lib/ssd1306_font.h"
+
+// Coluna em branco usada no espaçamento entre glifos
+static const uint8_t ssd1306_font_blank[1] = { 0x00 };
+
+uint8_t ssd1306_font_width(const ssd1306_font_t *font, const char *text) {
+  uint16_t w = 0;
+  while (*text)
+    w += ssd1306_font_glyph(font, ssd1306_utf8_next(&text))->width + font->spacing;
+  return w > 255 ? 255 : w;
+}
+
+// Com y múltiplo de 8 as colunas vão direto para o framebuffer, glifo após
+// glifo, e a linha inteira é marcada suja uma vez só; caso contrário cada
+// glifo passa por ssd1306_draw_bitmap() com deslocamento e máscara.
+uint8_t ssd1306_font_draw(ssd1306_t *ssd, const ssd1306_font_t *font, const char *text, uint8_t x, uint8_t y, uint8_t x_end) {
+  uint16_t col = x;
+  if (x_end > SSD1306_COLS(ssd))
+    x_end = SSD1306_COLS(ssd);
+  if (x >= x_end || y >= SSD1306_ROWS(ssd))
+    return x;
+
+  bool aligned = (y & 0b111) == 0;
+  uint8_t *byte = &ssd->ram_buffer[ssd1306_index(ssd, x, y >> 3)];
+  uint8_t diff = 0;
+
+  while (*text) {
+    const ssd1306_glyph_t *g = ssd1306_font_glyph(font, ssd1306_utf8_next(&text));
+    if (col + g->width > x_end)
+      break;
+    const uint8_t *src = &font->bitmap[g->offset];
+    if (aligned) {
+      for (uint8_t i = 0; i < g->width; ++i, byte += SSD1306_COL_STRIDE(ssd)) {
+        diff |= *byte ^ src[i];
+        *byte = src[i];
+      }
+      for (uint8_t s = 0; s < font->spacing && col + g->width + s < x_end; ++s, byte += SSD1306_COL_STRIDE(ssd)) {
+        diff |= *byte;
+        *byte = 0x00;
+      }
+    } else {
+      ssd1306_draw_bitmap(ssd, src, col, y, g->width, 1);
+      for (uint8_t s = 0; s < font->spacing && col + g->width + s < x_end; ++s)
+        ssd1306_draw_bitmap(ssd, ssd1306_font_blank, col + g->width + s, y, 1, 1);
+    }
+    col += g->width + font->spacing;
+  }
+
+  if (col > x_end)
+    col = x_end;
+  if (diff)
+    ssd1306_mark_dirty(ssd, x, y >> 3, col - 1, y >> 3);
+  return col;
+}
@@ -0,0 +1,53 @@
+#ifndef SSD1306_FONT_H
+#define SSD1306_FONT_H
+
+#include "lib/ssd1306.h"
+
+// Fontes proporcionais de uma página (8 linhas), constantes e em flash.
+// As colunas de todos os glifos ficam em sequência em bitmap, no formato de
+// página do SSD1306 (bit 0 no topo); glyphs dá o deslocamento e a largura
+// de cada glifo. Os códigos são agrupados em blocos de 32: blocks dá, para
+// cada bloco, o índice em glyphs do primeiro código do bloco, ou
+// SSD1306_FONT_NO_BLOCK. Achar um glifo custa dois acessos a tabela, sem
+// busca; códigos fora dos blocos ou com largura zero usam o glifo fallback.
+// O texto é lido como UTF-8 (ssd1306_utf8_next).
+
+#define SSD1306_FONT_BLOCK_BITS 5
+#define SSD1306_FONT_NO_BLOCK 0xFFFF
+
+typedef struct {
+  uint16_t offset; // Primeira coluna do glifo em bitmap
+  uint8_t width;
+} ssd1306_glyph_t;
+
+typedef struct {
+  const uint8_t *bitmap;
+  const ssd1306_glyph_t *glyphs;
+  const uint16_t *blocks;
+  uint16_t block_count;
+  uint16_t fallback; // Índice em glyphs do glifo para códigos sem glifo
+  uint8_t spacing;   // Colunas em branco depois de cada glifo
+} ssd1306_font_t;
+
+// Fonte gerada por tools/gen_font_prop.py (lib/font_prop.c)
+extern const ssd1306_font_t ssd1306_font_prop;
+
+static inline const ssd1306_glyph_t *ssd1306_font_glyph(const ssd1306_font_t *font, uint32_t code) {
+  uint32_t block = code >> SSD1306_FONT_BLOCK_BITS;
+  if (block < font->block_count && font->blocks[block] != SSD1306_FONT_NO_BLOCK) {
+    const ssd1306_glyph_t *g = &font->glyphs[font->blocks[block] + (code & ((1 << SSD1306_FONT_BLOCK_BITS) - 1))];
+    if (g->width)
+      return g;
+  }
+  return &font->glyphs[font->fallback];
+}
+
+uint8_t ssd1306_font_width(const ssd1306_font_t *font, const char *text);
+
+// Desenha o texto a partir de (x, y) só com glifos que terminam antes de
+// x_end (use a largura da tela para recortar só na borda); códigos sem
+// glifo e sequências UTF-8 inválidas saem como o glifo fallback. Retorna o
+// x logo após o último glifo.
+uint8_t ssd1306_font_draw(ssd1306_t *ssd, const ssd1306_font_t *font, const char *text, uint8_t x, uint8_t y, uint8_t x_end);
+
+#endif
@@ -0,0 +1,143 @@
+#include <string.h>
+#include "lib/ssd1306_text.h"
+#include "lib/font_big.h"
+
+static const uint32_t ssd1306_pow10[] = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+// Escreve os dígitos de value de trás para frente, terminando em end, com
+// pelo menos min_digits dígitos; retorna o primeiro caractere escrito
+static char *ssd1306_digits(char *end, uint32_t value, uint8_t min_digits) {
+  uint8_t n = 0;
+  do {
+    *--end = '0' + value % 10;
+    value /= 10;
+    ++n;
+  } while (value || n < min_digits);
+  return end;
+}
+
+// Núcleo comum: magnitude, sinal, casas decimais e preenchimento. O campo é
+// montado do fim para o começo e copiado para o início de buf.
+static uint8_t ssd1306_fmt(char *buf, uint32_t mag, bool negative, uint8_t decimals, uint8_t width, char pad) {
+  char field[SSD1306_FMT_MAX];
+  char *end = &field[SSD1306_FMT_MAX - 1];
+  char *p = end;
+  *end = '\0';
+
+  if (decimals > 9)
+    decimals = 9;
+  if (width > SSD1306_FMT_MAX - 1)
+    width = SSD1306_FMT_MAX - 1;
+  if (decimals) {
+    p = ssd1306_digits(p, mag % ssd1306_pow10[decimals], decimals);
+    *--p = '.';
+    mag /= ssd1306_pow10[decimals];
+  }
+  p = ssd1306_digits(p, mag, 1);
+
+  // Com zeros o sinal fica à esquerda do preenchimento ("-007")
+  if (pad == '0') {
+    while (end - p + negative < width)
+      *--p = '0';
+    if (negative)
+      *--p = '-';
+  } else {
+    if (negative)
+      *--p = '-';
+    while (end - p < width)
+      *--p = pad;
+  }
+
+  uint8_t len = end - p;
+  memcpy(buf, p, len + 1);
+  return len;
+}
+
+uint8_t ssd1306_fmt_uint(char *buf, uint32_t value, uint8_t width, char pad) {
+  return ssd1306_fmt(buf, value, false, 0, width, pad);
+}
+
+uint8_t ssd1306_fmt_int(char *buf, int32_t value, uint8_t width, char pad) {
+  return ssd1306_fmt_fixed(buf, value, 0, width, pad);
+}
+
+uint8_t ssd1306_fmt_fixed(char *buf, int32_t value, uint8_t decimals, uint8_t width, char pad) {
+  uint32_t mag = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+  return ssd1306_fmt(buf, mag, value < 0, decimals, width, pad);
+}
+
+uint8_t ssd1306_draw_text(ssd1306_t *ssd, const char *text, uint8_t x, uint8_t y) {
+  uint16_t col = x;
+  while (*text && col < SSD1306_COLS(ssd)) {
+    ssd1306_draw_char(ssd, ssd1306_ascii(ssd1306_utf8_next(&text)), col, y);
+    col += SSD1306_CHAR_W;
+  }
+  return col < SSD1306_COLS(ssd) ? col : SSD1306_COLS(ssd);
+}
+
+uint8_t ssd1306_draw_uint(ssd1306_t *ssd, uint32_t value, uint8_t x, uint8_t y, uint8_t width, char pad) {
+  char buf[SSD1306_FMT_MAX];
+  ssd1306_fmt_uint(buf, value, width, pad);
+  return ssd1306_draw_text(ssd, buf, x, y);
+}
+
+uint8_t ssd1306_draw_int(ssd1306_t *ssd, int32_t value, uint8_t x, uint8_t y, uint8_t width, char pad) {
+  char buf[SSD1306_FMT_MAX];
+  ssd1306_fmt_int(buf, value, width, pad);
+  return ssd1306_draw_text(ssd, buf, x, y);
+}
+
+uint8_t ssd1306_draw_fixed(ssd1306_t *ssd, int32_t value, uint8_t decimals, uint8_t x, uint8_t y, uint8_t width, char pad) {
+  char buf[SSD1306_FMT_MAX];
+  ssd1306_fmt_fixed(buf, value, decimals, width, pad);
+  return ssd1306_draw_text(ssd, buf, x, y);
+}
+
+uint8_t ssd1306_draw_text_right(ssd1306_t *ssd, const char *text, uint8_t x_end, uint8_t y) {
+  const char *p = text;
+  size_t w = 0;
+  while (*p && w < x_end) {
+    ssd1306_utf8_next(&p);
+    w += SSD1306_CHAR_W;
+  }
+  uint8_t x = w < x_end ? x_end - w : 0;
+  ssd1306_draw_text(ssd, text, x, y);
+  return x;
+}
+
+// Glifo ampliado já pronto na tabela gerada; NULL para caracteres sem glifo
+static const uint8_t *ssd1306_big_glyph(char c, uint8_t scale) {
+  if (c < FONT_BIG_FIRST || c > FONT_BIG_LAST)
+    return NULL;
+  switch (scale) {
+    case 2: return font_big2[c - FONT_BIG_FIRST];
+    case 3: return font_big3[c - FONT_BIG_FIRST];
+    case 4: return font_big4[c - FONT_BIG_FIRST];
+    default: return NULL;
+  }
+}
+
+uint8_t ssd1306_draw_big(ssd1306_t *ssd, const char *text, uint8_t x, uint8_t y, uint8_t scale) {
+  if (scale < 2 || scale > SSD1306_BIG_MAX)
+    return ssd1306_draw_text(ssd, text, x, y);
+
+  uint8_t w = SSD1306_CHAR_W * scale;
+  uint16_t col = x;
+  while (*text && col < SSD1306_COLS(ssd)) {
+    const uint8_t *glyph = ssd1306_big_glyph(ssd1306_ascii(ssd1306_utf8_next(&text)), scale);
+    if (glyph)
+      ssd1306_draw_bitmap(ssd, glyph, col, y, w, scale);
+    else
+      ssd1306_rect(ssd, y, col, w, 8 * scale, false, true);
+    col += w;
+  }
+  return col < SSD1306_COLS(ssd) ? col : SSD1306_COLS(ssd);
+}
+
+uint8_t ssd1306_draw_big_uint(ssd1306_t *ssd, uint32_t value, uint8_t x, uint8_t y, uint8_t scale, uint8_t width, char pad) {
+  char buf[SSD1306_FMT_MAX];
+  ssd1306_fmt_uint(buf, value, width, pad);
+  return ssd1306_draw_big(ssd, buf, x, y, scale);
+}
@@ -0,0 +1,39 @@
+#ifndef SSD1306_TEXT_H
+#define SSD1306_TEXT_H
+
+#include "lib/ssd1306.h"
+
+// Formatação de números e texto sem printf: os dígitos são gerados num
+// buffer pequeno na pilha e desenhados glifo a glifo com a fonte de font.h.
+// Nenhuma função quebra linha; o texto é recortado na borda direita.
+
+#define SSD1306_CHAR_W 8
+
+// Maior campo formatado, incluindo o '\0' (10 dígitos, sinal, ponto e preenchimento)
+#define SSD1306_FMT_MAX 16
+
+// Formatação em buf (pelo menos SSD1306_FMT_MAX bytes). width é a largura
+// mínima do campo, alinhado à direita com pad (' ' ou '0'); retorna o
+// tamanho do texto. Em ssd1306_fmt_fixed, value está em unidades de
+// 10^-decimals (1234 com 2 casas vira "12.34").
+uint8_t ssd1306_fmt_uint(char *buf, uint32_t value, uint8_t width, char pad);
+uint8_t ssd1306_fmt_int(char *buf, int32_t value, uint8_t width, char pad);
+uint8_t ssd1306_fmt_fixed(char *buf, int32_t value, uint8_t decimals, uint8_t width, char pad);
+
+// Desenho a partir de (x, y); retornam o x logo após o último caractere
+uint8_t ssd1306_draw_text(ssd1306_t *ssd, const char *text, uint8_t x, uint8_t y);
+uint8_t ssd1306_draw_uint(ssd1306_t *ssd, uint32_t value, uint8_t x, uint8_t y, uint8_t width, char pad);
+uint8_t ssd1306_draw_int(ssd1306_t *ssd, int32_t value, uint8_t x, uint8_t y, uint8_t width, char pad);
+uint8_t ssd1306_draw_fixed(ssd1306_t *ssd, int32_t value, uint8_t decimals, uint8_t x, uint8_t y, uint8_t width, char pad);
+
+// Texto alinhado à direita, terminando antes da coluna x_end; retorna o x inicial
+uint8_t ssd1306_draw_text_right(ssd1306_t *ssd, const char *text, uint8_t x_end, uint8_t y);
+
+// Dígitos ampliados 2x a 4x (de '-' a '9'; outros caracteres viram espaço),
+// copiados de tabelas geradas por tools/gen_font_big.py. Com y múltiplo de 8
+// cada glifo é uma cópia direta para o framebuffer. Escala 1 usa a fonte normal.
+#define SSD1306_BIG_MAX 4
+uint8_t ssd1306_draw_big(ssd1306_t *ssd, const char *text, uint8_t x, uint8_t y, uint8_t scale);
+uint8_t ssd1306_draw_big_uint(ssd1306_t *ssd, uint32_t value, uint8_t x, uint8_t y, uint8_t scale, uint8_t width, char pad);
+
+#endif
@@ -0,0 +1,150 @@
+#include "lib/ssd1306_tiles.h"
+#include "lib/font.h"
+
+void ssd1306_dl_init(ssd1306_dl_t *dl, ssd1306_dl_item_t *items, uint8_t capacity) {
+  dl->items = items;
+  dl->capacity = capacity;
+  dl->count = 0;
+}
+
+void ssd1306_dl_clear(ssd1306_dl_t *dl) {
+  dl->count = 0;
+}
+
+static bool ssd1306_dl_push(ssd1306_dl_t *dl, uint8_t op, bool value, uint8_t x, uint8_t y, uint8_t w, uint8_t h, const char *text) {
+  if (dl->count >= dl->capacity)
+    return false;
+  ssd1306_dl_item_t *item = &dl->items[dl->count++];
+  item->op = op;
+  item->value = value;
+  item->x = x;
+  item->y = y;
+  item->w = w;
+  item->h = h;
+  item->text = text;
+  return true;
+}
+
+bool ssd1306_dl_text(ssd1306_dl_t *dl, const char *text, uint8_t x, uint8_t y) {
+  return ssd1306_dl_push(dl, SSD1306_DL_TEXT, true, x, y, 0, 0, text);
+}
+
+bool ssd1306_dl_rect(ssd1306_dl_t *dl, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  return ssd1306_dl_push(dl, fill ? SSD1306_DL_FILL_RECT : SSD1306_DL_RECT, value, left, top, width, height, NULL);
+}
+
+bool ssd1306_dl_hline(ssd1306_dl_t *dl, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  return ssd1306_dl_push(dl, SSD1306_DL_HLINE, value, x0, y, x1, 0, NULL);
+}
+
+bool ssd1306_dl_vline(ssd1306_dl_t *dl, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  return ssd1306_dl_push(dl, SSD1306_DL_VLINE, value, x, y0, 0, y1, NULL);
+}
+
+// Mesma semântica de ssd1306_fill_area(), restrita às linhas da página
+static void ssd1306_dl_area(uint8_t *strip, const ssd1306_t *ssd, uint8_t page, int x0, int y0, int x1, int y1, bool value) {
+  int top = page * 8, bottom = top + 7;
+  if (x0 < 0) x0 = 0;
+  if (x1 >= ssd->width) x1 = ssd->width - 1;
+  if (y0 < top) y0 = top;
+  if (y1 > bottom) y1 = bottom;
+  if (y1 >= ssd->height) y1 = ssd->height - 1;
+  if (x0 > x1 || y0 > y1)
+    return;
+
+  uint8_t mask = (0xFF << (y0 & 0b111)) & (0xFF >> (7 - (y1 & 0b111)));
+  uint8_t bits = value ? mask : 0x00;
+  for (int x = x0; x <= x1; ++x)
+    strip[x] = (strip[x] & ~mask) | bits;
+}
+
+// Mesma semântica de ssd1306_draw_char(): glifo opaco, recortado nas bordas
+static void ssd1306_dl_char(uint8_t *strip, const ssd1306_t *ssd, uint8_t page, char c, uint8_t x, uint8_t y) {
+  uint8_t char_page = y >> 3;
+  uint8_t shift = y & 0b111;
+  uint8_t bits_shift, mask;
+
+  if (page == char_page) {
+    bits_shift = shift;
+    mask = 0xFF << shift;
+  } else if (shift && page == char_page + 1) {
+    bits_shift = 8 - shift;
+    mask = 0xFF >> (8 - shift);
+  } else {
+    return;
+  }
+
+  const uint8_t *glyph = &font[(c >= ' ' && c <= '~') ? (c - ' ') * 8 : 0];
+  for (uint8_t i = 0; i < 8; ++i) {
+    uint16_t col = x + i;
+    if (col >= ssd->width)
+      break;
+    uint8_t line = page == char_page ? glyph[i] << bits_shift : glyph[i] >> bits_shift;
+    strip[col] = (strip[col] & ~mask) | (line & mask);
+  }
+}
+
+// Percorre a string com a mesma decodificação UTF-8 e as mesmas regras de
+// quebra de ssd1306_draw_string()
+static void ssd1306_dl_string(uint8_t *strip, const ssd1306_t *ssd, uint8_t page, const char *str, uint8_t x, uint8_t y) {
+  while (*str) {
+    ssd1306_dl_char(strip, ssd, page, ssd1306_ascii(ssd1306_utf8_next(&str)), x, y);
+    x += 8;
+    if (x + 8 >= ssd->width) {
+      x = 0;
+      y += 8;
+    }
+    if (y + 8 >= ssd->height)
+      break;
+    if ((y >> 3) > page)
+      break; // O restante da string fica abaixo desta página
+  }
+}
+
+// Rasteriza a página indicada em dl->strip[1..width], partindo da tela limpa
+void ssd1306_dl_render_page(ssd1306_dl_t *dl, const ssd1306_t *ssd, uint8_t page) {
+  uint8_t *strip = &dl->strip[1];
+  for (uint8_t x = 0; x < ssd->width; ++x)
+    strip[x] = 0x00;
+
+  for (uint8_t i = 0; i < dl->count; ++i) {
+    const ssd1306_dl_item_t *item = &dl->items[i];
+    int right = item->x + item->w - 1;
+    int bottom = item->y + item->h - 1;
+    switch (item->op) {
+      case SSD1306_DL_TEXT:
+        ssd1306_dl_string(strip, ssd, page, item->text, item->x, item->y);
+        break;
+      case SSD1306_DL_FILL_RECT:
+        if (item->w && item->h)
+          ssd1306_dl_area(strip, ssd, page, item->x, item->y, right, bottom, item->value);
+        break;
+      case SSD1306_DL_RECT:
+        if (item->w && item->h) {
+          ssd1306_dl_area(strip, ssd, page, item->x, item->y, right, item->y, item->value);
+          ssd1306_dl_area(strip, ssd, page, item->x, bottom, right, bottom, item->value);
+          ssd1306_dl_area(strip, ssd, page, item->x, item->y, item->x, bottom, item->value);
+          ssd1306_dl_area(strip, ssd, page, right, item->y, right, bottom, item->value);
+        }
+        break;
+      case SSD1306_DL_HLINE:
+        ssd1306_dl_area(strip, ssd, page, item->x, item->y, item->w, item->y, item->value);
+        break;
+      case SSD1306_DL_VLINE:
+        ssd1306_dl_area(strip, ssd, page, item->x, item->y, item->x, item->h, item->value);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+// Rasteriza e envia a tela página por página; cada faixa vai ao painel
+// assim que fica pronta, usando uma janela de uma página
+void ssd1306_dl_flush(ssd1306_dl_t *dl, ssd1306_t *ssd) {
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    ssd1306_window_t w = { 0, ssd->width - 1, page, page };
+    ssd1306_dl_render_page(dl, ssd, page);
+    ssd1306_send_raw(ssd, &w, dl->strip, ssd->width);
+  }
+}
@@ -0,0 +1,46 @@
+#ifndef SSD1306_TILES_H
+#define SSD1306_TILES_H
+
+#include "lib/ssd1306.h"
+
+// Renderização em faixas para builds com pouca RAM: a tela é descrita por uma
+// lista de desenho e cada página (8 linhas) é rasterizada numa faixa de
+// WIDTH bytes e enviada logo em seguida. Não há framebuffer de tela inteira;
+// o ssd1306_t pode ser inicializado com ssd1306_init_bus().
+//
+// O resultado é idêntico, byte a byte, ao de desenhar os mesmos itens na
+// mesma ordem com as primitivas de ssd1306.h sobre uma tela limpa.
+
+typedef enum {
+  SSD1306_DL_TEXT,
+  SSD1306_DL_RECT,
+  SSD1306_DL_FILL_RECT,
+  SSD1306_DL_HLINE,
+  SSD1306_DL_VLINE
+} ssd1306_dl_op_t;
+
+typedef struct {
+  uint8_t op;
+  bool value;
+  uint8_t x, y;     // Texto/retângulo: canto superior esquerdo; linhas: x0/y0
+  uint8_t w, h;     // Retângulo: largura/altura; hline: x1 em w; vline: y1 em h
+  const char *text; // Precisa continuar válido até o envio
+} ssd1306_dl_item_t;
+
+typedef struct {
+  ssd1306_dl_item_t *items;
+  uint8_t count, capacity;
+  uint8_t strip[WIDTH + 1]; // strip[0] reservado para o prefixo de dados
+} ssd1306_dl_t;
+
+void ssd1306_dl_init(ssd1306_dl_t *dl, ssd1306_dl_item_t *items, uint8_t capacity);
+void ssd1306_dl_clear(ssd1306_dl_t *dl);
+bool ssd1306_dl_text(ssd1306_dl_t *dl, const char *text, uint8_t x, uint8_t y);
+bool ssd1306_dl_rect(ssd1306_dl_t *dl, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
+bool ssd1306_dl_hline(ssd1306_dl_t *dl, uint8_t x0, uint8_t x1, uint8_t y, bool value);
+bool ssd1306_dl_vline(ssd1306_dl_t *dl, uint8_t x, uint8_t y0, uint8_t y1, bool value);
+
+void ssd1306_dl_render_page(ssd1306_dl_t *dl, const ssd1306_t *ssd, uint8_t page);
+void ssd1306_dl_flush(ssd1306_dl_t *dl, ssd1306_t *ssd);
+
+#endif
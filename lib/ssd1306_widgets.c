@@ -0,0 +1,445 @@
+#include "lib/ssd1306_widgets.h"
+#include "lib/ssd1306_text.h"
+
+static void ssd1306_widget_box(ssd1306_widget_t *wg, uint8_t type, uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+  wg->type = type;
+  wg->invalid = true;
+  wg->x = x;
+  wg->y = y;
+  wg->w = w;
+  wg->h = h;
+  wg->font = NULL;
+}
+
+void ssd1306_widget_label(ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w, const char *text) {
+  ssd1306_widget_box(wg, SSD1306_WIDGET_LABEL, x, y, w, 8);
+  wg->text = text;
+}
+
+void ssd1306_widget_number(ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w, int32_t value, uint8_t decimals) {
+  ssd1306_widget_box(wg, SSD1306_WIDGET_NUMBER, x, y, w, 8);
+  wg->number.value = value;
+  wg->number.decimals = decimals;
+  wg->number.scale = 1;
+}
+
+void ssd1306_widget_bar(ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w, uint8_t h, int32_t value, int32_t max) {
+  ssd1306_widget_box(wg, SSD1306_WIDGET_BAR, x, y, w, h);
+  wg->bar.value = value;
+  wg->bar.max = max;
+}
+
+void ssd1306_widget_icon(ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t *bitmap) {
+  ssd1306_widget_box(wg, SSD1306_WIDGET_ICON, x, y, w, h);
+  wg->bitmap = bitmap;
+}
+
+// O ticker é sempre de uma página, alinhado a ela
+void ssd1306_widget_ticker(ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w, const char *text, uint8_t speed) {
+  ssd1306_widget_box(wg, SSD1306_WIDGET_TICKER, x, y & ~0b111, w, 8);
+  wg->font = &ssd1306_font_prop;
+  wg->ticker.text = text;
+  wg->ticker.speed = speed;
+  wg->ticker.mode = SSD1306_TICKER_IDLE;
+  wg->ticker.running = false;
+}
+
+// Caixa alinhada a páginas; o anel deve ter uma amostra por coluna para
+// cobrir a largura toda
+void ssd1306_widget_graph(ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t *samples, uint8_t size, int32_t max) {
+  ssd1306_widget_box(wg, SSD1306_WIDGET_GRAPH, x, y & ~0b111, w, (h + 7) & ~0b111);
+  wg->graph.value = 0;
+  wg->graph.max = max;
+  wg->graph.samples = samples;
+  wg->graph.size = size;
+  wg->graph.head = 0;
+  wg->graph.count = 0;
+  wg->graph.pending = 0;
+}
+
+void ssd1306_widget_push(ssd1306_widget_t *wg, uint8_t value) {
+  wg->graph.samples[wg->graph.head] = value;
+  if (++wg->graph.head == wg->graph.size)
+    wg->graph.head = 0;
+  if (wg->graph.count < wg->graph.size)
+    wg->graph.count++;
+  if (wg->graph.pending < 255)
+    wg->graph.pending++;
+  wg->graph.value = value;
+}
+
+// Cada tipo guarda o texto ou o valor em um membro diferente da
+// união; nos outros tipos esses bytes são ponteiros e estado que não mudam
+static const char **ssd1306_widget_text_ptr(ssd1306_widget_t *wg) {
+  switch (wg->type) {
+    case SSD1306_WIDGET_LABEL:
+      return &wg->text;
+    case SSD1306_WIDGET_TICKER:
+      return &wg->ticker.text;
+    default:
+      return NULL;
+  }
+}
+
+bool ssd1306_widget_set_text(ssd1306_widget_t *wg, const char *text) {
+  const char **current = ssd1306_widget_text_ptr(wg);
+  if (!current || *current == text)
+    return false;
+  *current = text;
+  wg->invalid = true;
+  return true;
+}
+
+static int32_t *ssd1306_widget_value(ssd1306_widget_t *wg) {
+  switch (wg->type) {
+    case SSD1306_WIDGET_NUMBER:
+      return &wg->number.value;
+    case SSD1306_WIDGET_BAR:
+      return &wg->bar.value;
+    default:
+      return NULL; // Gráficos recebem valores por ssd1306_widget_push()
+  }
+}
+
+static int32_t *ssd1306_widget_max(ssd1306_widget_t *wg) {
+  switch (wg->type) {
+    case SSD1306_WIDGET_BAR:
+      return &wg->bar.max;
+    case SSD1306_WIDGET_GRAPH:
+      return &wg->graph.max; // Nova escala: o gráfico é redesenhado inteiro
+    default:
+      return NULL;
+  }
+}
+
+bool ssd1306_widget_set_value(ssd1306_widget_t *wg, int32_t value) {
+  int32_t *current = ssd1306_widget_value(wg);
+  if (!current || *current == value)
+    return false;
+  *current = value;
+  wg->invalid = true;
+  return true;
+}
+
+bool ssd1306_widget_set_max(ssd1306_widget_t *wg, int32_t max) {
+  int32_t *current = ssd1306_widget_max(wg);
+  if (!current || *current == max)
+    return false;
+  *current = max;
+  wg->invalid = true;
+  return true;
+}
+
+bool ssd1306_widget_set_font(ssd1306_widget_t *wg, const ssd1306_font_t *font) {
+  if (wg->font == font)
+    return false;
+  wg->font = font;
+  wg->invalid = true;
+  return true;
+}
+
+// Número em dígitos ampliados; a caixa passa a ter 8 * scale linhas. Só
+// números têm escala: nos outros tipos nem a caixa muda
+bool ssd1306_widget_set_scale(ssd1306_widget_t *wg, uint8_t scale) {
+  if (wg->type != SSD1306_WIDGET_NUMBER)
+    return false;
+  if (scale < 1 || scale > SSD1306_BIG_MAX || wg->number.scale == scale)
+    return false;
+  wg->number.scale = scale;
+  wg->h = 8 * scale;
+  wg->invalid = true;
+  return true;
+}
+
+bool ssd1306_widget_set_bitmap(ssd1306_widget_t *wg, const uint8_t *bitmap) {
+  if (wg->type != SSD1306_WIDGET_ICON || wg->bitmap == bitmap)
+    return false;
+  wg->bitmap = bitmap;
+  wg->invalid = true;
+  return true;
+}
+
+void ssd1306_widget_invalidate(ssd1306_widget_t *wg) {
+  wg->invalid = true;
+}
+
+void ssd1306_widget_place(ssd1306_t *ssd, ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w) {
+  if (wg->x == x && wg->y == y && wg->w == w)
+    return;
+  ssd1306_rect(ssd, wg->y, wg->x, wg->w, wg->h, false, true);
+  wg->x = x;
+  wg->y = y;
+  wg->w = w;
+  wg->invalid = true;
+}
+
+// Texto na primeira linha da caixa, só com glifos inteiros; o resto da
+// caixa é apagado. Os glifos sobrescrevem as células inteiras, então nada
+// é apagado antes e só os bytes que mudam ficam sujos.
+static void ssd1306_widget_text(ssd1306_t *ssd, const ssd1306_widget_t *wg, const char *text, uint8_t scale) {
+  uint8_t cw = SSD1306_CHAR_W * scale, ch = 8 * scale;
+  uint16_t x = wg->x, x_end = wg->x + wg->w;
+  char glyph[2] = { 0, 0 };
+  if (wg->font) {
+    if (text)
+      x = ssd1306_font_draw(ssd, wg->font, text, wg->x, wg->y, x_end);
+  } else {
+    while (text && *text && x + cw <= x_end) {
+      glyph[0] = ssd1306_ascii(ssd1306_utf8_next(&text));
+      if (scale > 1)
+        ssd1306_draw_big(ssd, glyph, x, wg->y, scale);
+      else
+        ssd1306_draw_char(ssd, glyph[0], x, wg->y);
+      x += cw;
+    }
+  }
+  if (x < x_end)
+    ssd1306_rect(ssd, wg->y, x, x_end - x, ch, false, true);
+  if (wg->h > ch)
+    ssd1306_rect(ssd, wg->y + ch, wg->x, wg->w, wg->h - ch, false, true);
+}
+
+// Borda de 1 px e preenchimento proporcional a value / max
+static void ssd1306_widget_bar_draw(ssd1306_t *ssd, const ssd1306_widget_t *wg) {
+  if (wg->w < 3 || wg->h < 3)
+    return;
+  ssd1306_rect(ssd, wg->y, wg->x, wg->w, wg->h, true, false);
+
+  uint8_t inner = wg->w - 2;
+  int32_t value = wg->bar.value < 0 ? 0 : wg->bar.value;
+  uint8_t filled = 0;
+  if (wg->bar.max > 0)
+    filled = value >= wg->bar.max ? inner : (uint8_t)(((int64_t)value * inner) / wg->bar.max);
+  if (filled)
+    ssd1306_rect(ssd, wg->y + 1, wg->x + 1, filled, wg->h - 2, true, true);
+  if (filled < inner)
+    ssd1306_rect(ssd, wg->y + 1, wg->x + 1 + filled, inner - filled, wg->h - 2, false, true);
+}
+
+// Próxima coluna do texto do ticker, repetindo-o depois de um intervalo
+static uint8_t ssd1306_ticker_column(ssd1306_widget_t *wg) {
+  const ssd1306_font_t *font = wg->font;
+  for (;;) {
+    const ssd1306_glyph_t *g = wg->ticker.glyph;
+    if (g) {
+      uint8_t col = wg->ticker.col++;
+      if (col < g->width)
+        return font->bitmap[g->offset + col];
+      if (col < g->width + font->spacing)
+        return 0x00;
+      wg->ticker.glyph = NULL;
+    }
+    if (*wg->ticker.next) {
+      wg->ticker.glyph = ssd1306_font_glyph(font, ssd1306_utf8_next(&wg->ticker.next));
+      wg->ticker.col = 0;
+    } else if (wg->ticker.blank) {
+      wg->ticker.blank--;
+      return 0x00;
+    } else {
+      wg->ticker.next = wg->ticker.text;
+      wg->ticker.blank = SSD1306_TICKER_GAP;
+    }
+  }
+}
+
+// Texto que cabe na tela fica parado no framebuffer e o painel o gira;
+// texto maior preenche a caixa com as primeiras colunas
+static void ssd1306_ticker_draw(ssd1306_t *ssd, ssd1306_widget_t *wg) {
+  const char *text = wg->ticker.text;
+  wg->ticker.running = false;
+  wg->ticker.next = text ? text : "";
+  wg->ticker.glyph = NULL;
+  wg->ticker.blank = 0;
+
+  if (!text || !*text) {
+    wg->ticker.mode = SSD1306_TICKER_IDLE;
+    ssd1306_rect(ssd, wg->y, wg->x, wg->w, wg->h, false, true);
+  } else if (wg->x == 0 && wg->w == SSD1306_COLS(ssd) && ssd1306_font_width(wg->font, text) <= wg->w) {
+    wg->ticker.mode = SSD1306_TICKER_CONTINUOUS;
+    ssd1306_widget_text(ssd, wg, text, 1);
+  } else {
+    wg->ticker.mode = SSD1306_TICKER_STEP;
+    for (uint8_t i = 0; i < wg->w; ++i) {
+      uint8_t col = ssd1306_ticker_column(wg);
+      ssd1306_draw_bitmap(ssd, &col, wg->x + i, wg->y, 1, 1);
+    }
+  }
+}
+
+// Quadros do painel entre passos para cada ssd1306_scroll_speed_t (o valor
+// do comando é o índice) e duração aproximada de um quadro com a sequência
+// de inicialização: 370 kHz / ((1 + 15 + 50) * 64 linhas), cerca de 88 Hz
+static const uint16_t ssd1306_scroll_frames[8] = { 5, 64, 128, 256, 3, 4, 25, 2 };
+#define SSD1306_FRAME_US 11400
+
+// O modo coluna a coluna anda no mesmo ritmo que o painel rolaria sozinho
+static uint32_t ssd1306_ticker_period_ms(const ssd1306_widget_t *wg) {
+  return (ssd1306_scroll_frames[wg->ticker.speed & 0x07] * SSD1306_FRAME_US + 999) / 1000;
+}
+
+// Há algo a enviar fora das páginas dadas?
+static bool ssd1306_dirty_outside(const ssd1306_t *ssd, uint8_t pages) {
+  if (!ssd->dirty)
+    return false;
+  const ssd1306_window_t *w = &ssd->dirty_window;
+  uint8_t window = ((1 << (w->page1 + 1)) - 1) & ~((1 << w->page0) - 1);
+  return window & ~pages;
+}
+
+uint32_t ssd1306_widget_scroll(ssd1306_t *ssd, ssd1306_widget_t *wg, uint32_t now_ms) {
+  if (wg->type != SSD1306_WIDGET_TICKER || wg->invalid || !ssd->online)
+    return 0;
+  uint8_t page = wg->y >> 3;
+  bool scrolling = ssd->scroll_pages & (1 << page);
+  uint32_t period = ssd1306_ticker_period_ms(wg);
+
+  switch (wg->ticker.mode) {
+    case SSD1306_TICKER_CONTINUOUS:
+      // Com a rolagem ligada o painel não aceita escrita na RAM, nem nas
+      // outras páginas: ela é desligada enquanto houver algo a enviar e
+      // religada, com o texto de volta ao início, numa chamada seguinte
+      if (ssd1306_dirty_outside(ssd, 1 << page)) {
+        if (ssd->scroll_pages)
+          ssd1306_scroll_stop(ssd);
+        wg->ticker.running = false;
+        return period;
+      }
+      // Religa também depois de ssd1306_recover(), que desliga a rolagem
+      if (!wg->ticker.running || !scrolling) {
+        if (ssd->scroll_pages)
+          ssd1306_scroll_stop(ssd);
+        ssd1306_send_dirty(ssd); // O texto precisa estar no painel antes de girar
+        ssd1306_scroll_start(ssd, true, page, page, wg->ticker.speed, 0);
+        wg->ticker.running = true;
+      }
+      return 0;
+    case SSD1306_TICKER_STEP: {
+      if (scrolling)
+        ssd1306_scroll_stop(ssd);
+      // Aqui running indica que o prazo do próximo passo já foi marcado
+      if (!wg->ticker.running) {
+        wg->ticker.due_ms = now_ms + period;
+        wg->ticker.running = true;
+      }
+      int32_t left = (int32_t) (wg->ticker.due_ms - now_ms);
+      if (left > 0)
+        return left;
+      ssd1306_scroll_column(ssd, true, wg->x, wg->x + wg->w - 1, page, page);
+      uint8_t col = ssd1306_ticker_column(wg);
+      ssd1306_draw_bitmap(ssd, &col, wg->x + wg->w - 1, wg->y, 1, 1);
+      // Um passo por prazo; com a chamada atrasada mais de um passo o ritmo
+      // recomeça a partir de agora, sem pular colunas
+      wg->ticker.due_ms += period;
+      if ((int32_t) (wg->ticker.due_ms - now_ms) <= 0)
+        wg->ticker.due_ms = now_ms + period;
+      return wg->ticker.due_ms - now_ms;
+    }
+    default:
+      if (scrolling)
+        ssd1306_scroll_stop(ssd);
+      return 0;
+  }
+}
+
+// Amostra com a idade dada (0 = a mais recente) já convertida em linha da
+// caixa, de 0 (topo) a h - 1 (base)
+static uint8_t ssd1306_graph_row(const ssd1306_widget_t *wg, uint8_t age) {
+  uint8_t i = (wg->graph.head + wg->graph.size - 1 - age) % wg->graph.size;
+  int32_t v = wg->graph.samples[i];
+  int32_t top = wg->h - 1;
+  if (wg->graph.max > 0)
+    v = v >= wg->graph.max ? top : v * top / wg->graph.max;
+  else
+    v = 0;
+  return top - v;
+}
+
+// Coluna na posição c da caixa: segmento vertical entre a amostra e a
+// anterior, o que liga os pontos numa linha contínua. Os bytes são escritos
+// inteiros, página a página, sem passar por ssd1306_pixel().
+static void ssd1306_graph_column(ssd1306_t *ssd, const ssd1306_widget_t *wg, uint8_t c) {
+  uint8_t age = wg->w - 1 - c;
+  int16_t a = -1, b = -1;
+  if (age < wg->graph.count) {
+    a = ssd1306_graph_row(wg, age);
+    b = age + 1 < wg->graph.count ? ssd1306_graph_row(wg, age + 1) : a;
+    if (a > b) {
+      int16_t t = a;
+      a = b;
+      b = t;
+    }
+  }
+  for (uint8_t page = 0; page < wg->h / 8; ++page) {
+    int16_t lo = a > page * 8 ? a : page * 8;
+    int16_t hi = b < page * 8 + 7 ? b : page * 8 + 7;
+    uint8_t byte = 0;
+    if (a >= 0 && lo <= hi)
+      byte = (0xFF >> (7 - (hi - lo))) << (lo - page * 8);
+    ssd->ram_buffer[ssd1306_index(ssd, wg->x + c, (wg->y >> 3) + page)] = byte;
+  }
+}
+
+// Com poucas amostras novas o gráfico anda por deslocamento, de uma vez só;
+// caso contrário (ou com o widget inválido) é refeito coluna a coluna. Em
+// ambos os casos a área inteira fica suja, pois todas as colunas mudam de
+// lugar: o deslocamento poupa desenho, não tráfego no barramento.
+static void ssd1306_graph_draw(ssd1306_t *ssd, ssd1306_widget_t *wg) {
+  uint8_t page0 = wg->y >> 3, page1 = page0 + wg->h / 8 - 1;
+  uint8_t x1 = wg->x + wg->w - 1;
+  uint8_t fresh = wg->graph.pending;
+  if (wg->invalid || fresh >= wg->w) {
+    fresh = wg->w;
+  } else {
+    ssd1306_shift_columns(ssd, true, wg->x, x1, page0, page1, fresh);
+    // A primeira coluna perdeu a amostra anterior, que saiu do anel
+    ssd1306_graph_column(ssd, wg, 0);
+  }
+  for (uint8_t c = wg->w - fresh; c < wg->w; ++c)
+    ssd1306_graph_column(ssd, wg, c);
+  wg->graph.pending = 0;
+  ssd1306_mark_dirty(ssd, wg->x, page0, x1, page1);
+}
+
+// Redesenha o widget se estiver inválido; retorna true se desenhou
+bool ssd1306_widget_draw(ssd1306_t *ssd, ssd1306_widget_t *wg) {
+  if (wg->type == SSD1306_WIDGET_GRAPH && (wg->invalid || wg->graph.pending)) {
+    ssd1306_graph_draw(ssd, wg);
+    wg->invalid = false;
+    return true;
+  }
+  if (!wg->invalid)
+    return false;
+  wg->invalid = false;
+
+  switch (wg->type) {
+    case SSD1306_WIDGET_LABEL:
+      ssd1306_widget_text(ssd, wg, wg->text, 1);
+      break;
+    case SSD1306_WIDGET_NUMBER: {
+      char buf[SSD1306_FMT_MAX];
+      ssd1306_fmt_fixed(buf, wg->number.value, wg->number.decimals, 0, ' ');
+      ssd1306_widget_text(ssd, wg, buf, wg->number.scale);
+      break;
+    }
+    case SSD1306_WIDGET_BAR:
+      ssd1306_widget_bar_draw(ssd, wg);
+      break;
+    case SSD1306_WIDGET_ICON:
+      ssd1306_draw_bitmap(ssd, wg->bitmap, wg->x, wg->y, wg->w, (wg->h + 7) / 8);
+      break;
+    case SSD1306_WIDGET_TICKER:
+      ssd1306_ticker_draw(ssd, wg);
+      break;
+    default:
+      break;
+  }
+  return true;
+}
+
+// Redesenha os widgets inválidos da lista; retorna quantos foram redesenhados
+uint8_t ssd1306_widgets_draw(ssd1306_t *ssd, ssd1306_widget_t *widgets, uint8_t count) {
+  uint8_t drawn = 0;
+  for (uint8_t i = 0; i < count; ++i)
+    drawn += ssd1306_widget_draw(ssd, &widgets[i]);
+  return drawn;
+}
@@ -0,0 +1,106 @@
+#ifndef SSD1306_WIDGETS_H
+#define SSD1306_WIDGETS_H
+
+#include "lib/ssd1306.h"
+#include "lib/ssd1306_font.h"
+
+// Widgets retidos: cada widget guarda sua caixa (x, y, w, h) e o valor
+// exibido. Os setters só invalidam o widget quando o valor muda e o desenho
+// só refaz widgets inválidos, sempre dentro da própria caixa. Como o
+// framebuffer marca sujo apenas o byte que muda, atualizar um campo suja
+// apenas os bytes dele e o envio seguinte cobre só as páginas dele.
+
+typedef enum {
+  SSD1306_WIDGET_LABEL,  // Texto numa linha, recortado na caixa
+  SSD1306_WIDGET_NUMBER, // Número inteiro ou de ponto fixo
+  SSD1306_WIDGET_BAR,    // Barra de progresso com borda
+  SSD1306_WIDGET_ICON,   // Bitmap no formato de ssd1306_draw_bitmap()
+  SSD1306_WIDGET_TICKER, // Texto rolando numa página, pela rolagem do painel
+  SSD1306_WIDGET_GRAPH   // Histórico de amostras, uma coluna por amostra
+} ssd1306_widget_type_t;
+
+// Colunas em branco entre o fim do texto do ticker e a repetição seguinte
+#define SSD1306_TICKER_GAP 16
+
+typedef enum {
+  SSD1306_TICKER_IDLE,       // Sem texto, nada rola
+  SSD1306_TICKER_CONTINUOUS, // Cabe na tela: o painel rola sozinho
+  SSD1306_TICKER_STEP        // Maior que a caixa: uma coluna por passo
+} ssd1306_ticker_mode_t;
+
+typedef struct {
+  uint8_t type;
+  bool invalid;
+  uint8_t x, y, w, h;
+  const ssd1306_font_t *font; // Label: fonte proporcional, ou NULL para a de 8x8
+  union {
+    const char *text;  // Label: comparado por ponteiro
+    struct {
+      int32_t value;
+      uint8_t decimals;
+      uint8_t scale; // 1 a SSD1306_BIG_MAX; a caixa tem 8 * scale linhas
+    } number;
+    struct {
+      int32_t value, max;
+    } bar;
+    const uint8_t *bitmap; // Ícone: w colunas por h / 8 páginas
+    struct {
+      const char *text; // Trocado por ssd1306_widget_set_text()
+      const char *next; // Próximo código a entrar pela direita
+      const ssd1306_glyph_t *glyph;
+      uint8_t col;      // Próxima coluna de glyph, incluindo o espaçamento
+      uint8_t blank;    // Colunas do intervalo entre repetições ainda por vir
+      uint8_t speed;    // ssd1306_scroll_speed_t; também dá o ritmo coluna a coluna
+      uint8_t mode;
+      bool running;     // Rolagem contínua ligada no painel, ou prazo marcado
+      uint32_t due_ms;  // Prazo do próximo passo coluna a coluna
+    } ticker;
+    struct {
+      int32_t value, max; // Como em bar: última amostra e fundo de escala
+      uint8_t *samples;   // Anel com size amostras, fornecido por quem cria
+      uint8_t size, head, count;
+      uint8_t pending;    // Amostras ainda não desenhadas
+    } graph;
+  };
+} ssd1306_widget_t;
+
+void ssd1306_widget_label(ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w, const char *text);
+void ssd1306_widget_number(ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w, int32_t value, uint8_t decimals);
+void ssd1306_widget_bar(ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w, uint8_t h, int32_t value, int32_t max);
+void ssd1306_widget_icon(ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t *bitmap);
+void ssd1306_widget_ticker(ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w, const char *text, uint8_t speed);
+void ssd1306_widget_graph(ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t *samples, uint8_t size, int32_t max);
+
+// Retornam true se o widget foi invalidado. set_text vale para rótulo e
+// ticker; set_value para número e barra; set_max para barra e gráfico;
+// set_scale para número; set_bitmap para ícone. Nos demais tipos nada muda.
+bool ssd1306_widget_set_text(ssd1306_widget_t *wg, const char *text);
+bool ssd1306_widget_set_value(ssd1306_widget_t *wg, int32_t value);
+bool ssd1306_widget_set_max(ssd1306_widget_t *wg, int32_t max);
+bool ssd1306_widget_set_font(ssd1306_widget_t *wg, const ssd1306_font_t *font);
+bool ssd1306_widget_set_scale(ssd1306_widget_t *wg, uint8_t scale);
+bool ssd1306_widget_set_bitmap(ssd1306_widget_t *wg, const uint8_t *bitmap);
+void ssd1306_widget_invalidate(ssd1306_widget_t *wg);
+
+// Gráfico: acrescenta uma amostra ao anel. O desenho seguinte desloca o
+// gráfico uma coluna para a esquerda (um memmove da área) e desenha só a
+// coluna nova; a janela suja é a área do gráfico e nada fora dela.
+void ssd1306_widget_push(ssd1306_widget_t *wg, uint8_t value);
+
+// Apaga a caixa antiga na tela e passa o widget para a nova posição
+void ssd1306_widget_place(ssd1306_t *ssd, ssd1306_widget_t *wg, uint8_t x, uint8_t y, uint8_t w);
+
+// Redesenham apenas widgets inválidos (e gráficos com amostras novas)
+bool ssd1306_widget_draw(ssd1306_t *ssd, ssd1306_widget_t *wg);
+uint8_t ssd1306_widgets_draw(ssd1306_t *ssd, ssd1306_widget_t *widgets, uint8_t count);
+
+// Ticker: o desenho só prepara o framebuffer; os comandos de rolagem saem
+// aqui, que deve ser chamada com o barramento livre e antes do envio do
+// quadro. Um texto que cabe na largura toda da tela rola pelo painel sem
+// nenhum tráfego por quadro, mas só enquanto nada mais precisa ser enviado;
+// um texto maior avança uma coluna a cada prazo vencido, no ritmo de speed,
+// e só a coluna que entra é enviada. now_ms é um relógio qualquer em ms.
+// Retorna em quantos ms ela precisa ser chamada de novo, ou 0 se não precisa.
+uint32_t ssd1306_widget_scroll(ssd1306_t *ssd, ssd1306_widget_t *wg, uint32_t now_ms);
+
+#endif
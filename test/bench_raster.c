@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lib/ssd1306.h"
+#include "lib/ssd1306_font.h"
+
+// Primitivas retangulares: núcleo de spans (ssd1306_fill_area) contra as
+// versões antigas, pixel a pixel. Primeiro confere que as duas desenham o
+// mesmo; depois mede o tempo por chamada. Por último, o custo por glifo do
+// texto: fonte ASCII fixa contra a fonte proporcional em UTF-8. No host (ctest) o resultado sai
+// em ns; na placa (opção SSD1306_BENCH do CMakeLists.txt da raiz) em ciclos
+// de clk_sys, pela saída USB.
+
+#ifdef PICO_ON_DEVICE
+#include "hardware/clocks.h"
+
+static uint64_t agora_ns(void) {
+  return time_us_64() * 1000;
+}
+#define UNIDADE "ciclos"
+#define CONVERTE(ns) ((ns) * (clock_get_hz(clk_sys) / 1000000) / 1000)
+#define REPETICOES 200
+#else
+#include <time.h>
+
+static uint64_t agora_ns(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000000u + t.tv_nsec;
+}
+#define UNIDADE "ns"
+#define CONVERTE(ns) (ns)
+#define REPETICOES 2000
+#endif
+
+// Implementações anteriores ao núcleo de spans
+static void antigo_pixel(ssd1306_t *ssd, int x, int y, bool value) {
+  if (x >= 0 && y >= 0 && x < SSD1306_COLS(ssd) && y < SSD1306_ROWS(ssd))
+    ssd1306_pixel(ssd, x, y, value);
+}
+
+static void antigo_fill(ssd1306_t *ssd, bool value) {
+  for (uint8_t y = 0; y < SSD1306_ROWS(ssd); ++y)
+    for (uint8_t x = 0; x < SSD1306_COLS(ssd); ++x)
+      ssd1306_pixel(ssd, x, y, value);
+}
+
+static void antigo_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  for (int x = x0; x <= x1; ++x)
+    antigo_pixel(ssd, x, y, value);
+}
+
+static void antigo_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  for (int y = y0; y <= y1; ++y)
+    antigo_pixel(ssd, x, y, value);
+}
+
+static void antigo_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  if (width == 0 || height == 0)
+    return;
+  for (int x = left; x < left + width; ++x) {
+    antigo_pixel(ssd, x, top, value);
+    antigo_pixel(ssd, x, top + height - 1, value);
+  }
+  for (int y = top; y < top + height; ++y) {
+    antigo_pixel(ssd, left, y, value);
+    antigo_pixel(ssd, left + width - 1, y, value);
+  }
+  if (fill)
+    for (int x = left + 1; x < left + width - 1; ++x)
+      for (int y = top + 1; y < top + height - 1; ++y)
+        antigo_pixel(ssd, x, y, value);
+}
+
+static int conferir(ssd1306_t *novo, ssd1306_t *antigo) {
+  srand(4);
+  for (int k = 0; k < 20000; ++k) {
+    int x = rand() % 140, y = rand() % 70, a = rand() % 130, b = rand() % 70;
+    bool v = rand() & 1;
+    switch (rand() % 4) {
+    case 0: {
+      bool f = rand() & 1;
+      ssd1306_rect(novo, y, x, a, b, v, f);
+      antigo_rect(antigo, y, x, a, b, v, f);
+      break;
+    }
+    case 1:
+      if (x <= a) {
+        ssd1306_hline(novo, x, a, y, v);
+        antigo_hline(antigo, x, a, y, v);
+      }
+      break;
+    case 2:
+      if (y <= b) {
+        ssd1306_vline(novo, x, y, b, v);
+        antigo_vline(antigo, x, y, b, v);
+      }
+      break;
+    case 3:
+      if (rand() % 50 == 0) {
+        ssd1306_fill(novo, v);
+        antigo_fill(antigo, v);
+      }
+      break;
+    }
+    if (memcmp(novo->ram_buffer, antigo->ram_buffer, novo->bufsize)) {
+      printf("primitivas divergem na operação %d\n", k);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Tempo por chamada, ou por unidade quando cada chamada faz "por" delas
+#define MEDIR_POR(nome, n, por, chamada)                               \
+  do {                                                                 \
+    uint64_t t0 = agora_ns();                                          \
+    for (int i = 0; i < (n); ++i)                                      \
+      chamada;                                                         \
+    printf("%-26s %8llu " UNIDADE "\n", nome,                          \
+           (unsigned long long)CONVERTE((agora_ns() - t0) / (n) / (por))); \
+  } while (0)
+#define MEDIR(nome, n, chamada) MEDIR_POR(nome, n, 1, chamada)
+
+// 17 glifos cada, todos dentro da linha; o acentuado tem 3 de dois bytes
+#define TEXTO_ASCII    "Lotacao maxima: 8"
+#define TEXTO_UTF8     "Lotação máxima: 8"
+#define TEXTO_GLIFOS   17
+
+int main(void) {
+  static ssd1306_t novo, antigo;
+
+#ifdef PICO_ON_DEVICE
+  stdio_init_all();
+  sleep_ms(3000);
+#endif
+  if (!ssd1306_init(&novo, 128, 64, false, 0x3C, i2c1) ||
+      !ssd1306_init(&antigo, 128, 64, false, 0x3C, i2c1) ||
+      conferir(&novo, &antigo))
+    return 1;
+
+#ifdef SSD1306_FIXED_GEOMETRY
+  printf("geometria fixa (SSD1306_FIXED_GEOMETRY)\n");
+#else
+  printf("geometria em tempo de execução\n");
+#endif
+  int n = REPETICOES, m = REPETICOES / 20;
+  MEDIR("fill (spans)", n, ssd1306_fill(&novo, i & 1));
+  MEDIR("fill (pixel a pixel)", m, antigo_fill(&antigo, i & 1));
+  MEDIR("rect 122x60 (spans)", n, ssd1306_rect(&novo, 2, 3, 122, 60, i & 1, false));
+  MEDIR("rect 122x60 (pixel)", m, antigo_rect(&antigo, 2, 3, 122, 60, i & 1, false));
+  MEDIR("rect cheio 60x30 (spans)", n, ssd1306_rect(&novo, 5, 9, 60, 30, i & 1, true));
+  MEDIR("rect cheio 60x30 (pixel)", m, antigo_rect(&antigo, 5, 9, 60, 30, i & 1, true));
+  MEDIR("hline 0..127 (spans)", n, ssd1306_hline(&novo, 0, 127, 13, i & 1));
+  MEDIR("hline 0..127 (pixel)", m, antigo_hline(&antigo, 0, 127, 13, i & 1));
+  MEDIR("vline 0..63 (spans)", n, ssd1306_vline(&novo, 77, 0, 63, i & 1));
+  MEDIR("vline 0..63 (pixel)", m, antigo_vline(&antigo, 77, 0, 63, i & 1));
+
+  printf("texto, por glifo\n");
+  MEDIR_POR("ASCII fixa", n, TEXTO_GLIFOS, ssd1306_draw_string(&novo, TEXTO_ASCII, 0, 8 * (i & 7)));
+  MEDIR_POR("proporcional, ASCII", n, TEXTO_GLIFOS,
+            ssd1306_font_draw(&novo, &ssd1306_font_prop, TEXTO_ASCII, 0, 8 * (i & 7), 128));
+  MEDIR_POR("proporcional, UTF-8", n, TEXTO_GLIFOS,
+            ssd1306_font_draw(&novo, &ssd1306_font_prop, TEXTO_UTF8, 0, 8 * (i & 7), 128));
+  return 0;
+}
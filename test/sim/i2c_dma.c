@@ -0,0 +1,100 @@
+#include <string.h>
+#include "sim.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+// Controlador I2C e DMA: os registradores são memória comum, os canais só
+// guardam origem e quantidade, e a interrupção do I2C é chamada pelos
+// testes ao "fim" da transferência.
+
+#define CANAIS 12
+
+static i2c_hw_t regs[2];
+static const volatile void *origem[CANAIS];
+static uint32_t pendente[CANAIS], enviado[CANAIS];
+static int proximo_canal;
+static irq_handler_t tratadores[32];
+
+i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) { return &regs[i2c == i2c1]; }
+i2c_inst_t *i2c_get_instance(uint index) { return index ? i2c1 : i2c0; }
+uint i2c_hw_index(i2c_inst_t *i2c) { return i2c == i2c1; }
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) { (void) i2c; (void) is_tx; return 0; }
+i2c_hw_t *sim_i2c_hw(uint bus) { return &regs[bus]; }
+
+int dma_claim_unused_channel(bool required) {
+  (void) required;
+  return proximo_canal < CANAIS ? proximo_canal++ : -1;
+}
+
+void dma_channel_unclaim(uint ch) { (void) ch; }
+
+dma_channel_config dma_channel_get_default_config(uint ch) {
+  (void) ch;
+  return (dma_channel_config){ 0 };
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size s) { (void) c; (void) s; }
+void channel_config_set_read_increment(dma_channel_config *c, bool b) { (void) c; (void) b; }
+void channel_config_set_write_increment(dma_channel_config *c, bool b) { (void) c; (void) b; }
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) { (void) c; (void) dreq; }
+
+void dma_channel_configure(uint ch, const dma_channel_config *c, volatile void *w, const volatile void *r, uint count, bool trigger) {
+  (void) c;
+  (void) w;
+  origem[ch] = r;
+  enviado[ch] = count;
+  pendente[ch] = trigger ? count : 0;
+}
+
+void dma_channel_transfer_from_buffer_now(uint ch, const volatile void *r, uint32_t count) {
+  origem[ch] = r;
+  enviado[ch] = pendente[ch] = count;
+}
+
+void dma_channel_abort(uint ch) { pendente[ch] = 0; }
+bool dma_channel_is_busy(uint ch) { return pendente[ch] != 0; }
+bool sim_dma_ocupado(uint canal) { return pendente[canal] != 0; }
+
+const uint16_t *sim_dma_palavras(uint canal, uint32_t *total) {
+  *total = enviado[canal];
+  return (const uint16_t *)origem[canal];
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t h) { tratadores[num] = h; }
+void irq_add_shared_handler(uint num, irq_handler_t h, uint8_t prio) { (void) prio; tratadores[num] = h; }
+void irq_set_enabled(uint num, bool en) { (void) num; (void) en; }
+
+static void interromper(uint bus, uint32_t status) {
+  regs[bus].intr_stat = status & regs[bus].intr_mask;
+  if (regs[bus].intr_stat)
+    tratadores[bus ? I2C1_IRQ : I2C0_IRQ]();
+  regs[bus].intr_stat = 0;
+}
+
+// Cada RESTART fecha a transação anterior; STOP fecha a última
+void sim_i2c_concluir(uint canal, uint bus) {
+  const uint16_t *w = (const uint16_t *)origem[canal];
+  static uint8_t tx[2048];
+  size_t n = 0;
+
+  for (uint32_t i = 0; i < pendente[canal]; ++i) {
+    if ((w[i] & I2C_IC_DATA_CMD_RESTART_BITS) && n) {
+      sim_painel_receber(bus, tx, n);
+      n = 0;
+    }
+    tx[n++] = w[i] & 0xFF;
+    if (w[i] & I2C_IC_DATA_CMD_STOP_BITS) {
+      sim_painel_receber(bus, tx, n);
+      n = 0;
+    }
+  }
+  sim_us += (pendente[canal] + 1) * 23;
+  pendente[canal] = 0;
+  interromper(bus, I2C_IC_INTR_STAT_R_STOP_DET_BITS);
+}
+
+// NACK no endereço: nada chega ao painel e o canal continua com tudo pendente
+void sim_i2c_nack(uint canal, uint bus) {
+  (void) canal;
+  interromper(bus, I2C_IC_INTR_STAT_R_TX_ABRT_BITS);
+}
@@ -0,0 +1,189 @@
+#include <string.h>
+#include "sim/matriz.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+#include "hardware/clocks.h"
+
+pio_hw_t pio0_hw_s, pio1_hw_s;
+
+bool sim_pio_shift_direita, sim_pio_autopull;
+uint sim_pio_limiar;
+bool sim_pio_fifo_tx;
+int sim_matriz_dma_tamanho = -1;
+int sim_matriz_quadros;
+uint32_t sim_matriz_fio[64];
+uint sim_matriz_palavras;
+void (*sim_religar)(void);
+
+static const uint16_t *programa;
+static uint8_t programa_tamanho;
+
+static const uint32_t *dma_origem;
+static uint32_t dma_total;
+static bool dma_ocupado, dma_irq;
+static irq_handler_t tratador_dma;
+
+static hardware_alarm_callback_t alarme_cb;
+static bool alarme_armado;
+
+static repeating_timer_t *timer;
+
+// PIO: a configuração vai em pio_sm_config campo a campo, sem o formato
+// dos registradores
+uint pio_add_program(PIO pio, const struct pio_program *p) {
+  (void) pio;
+  programa = p->instructions;
+  programa_tamanho = p->length;
+  return 0;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) { (void) pio; (void) required; return 0; }
+void pio_gpio_init(PIO pio, uint pin) { (void) pio; (void) pin; }
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin, uint count, bool out) {
+  (void) pio; (void) sm; (void) pin; (void) count; (void) out;
+}
+pio_sm_config pio_get_default_sm_config(void) { return (pio_sm_config){ 0 }; }
+void sm_config_set_wrap(pio_sm_config *c, uint t, uint w) { (void) c; (void) t; (void) w; }
+void sm_config_set_sideset(pio_sm_config *c, uint bits, bool opt, bool pindirs) {
+  (void) c; (void) bits; (void) opt; (void) pindirs;
+}
+void sm_config_set_sideset_pins(pio_sm_config *c, uint pin) { (void) c; (void) pin; }
+void sm_config_set_out_shift(pio_sm_config *c, bool right, bool autopull, uint threshold) {
+  c->shiftctrl = (right ? 1 : 0) | (autopull ? 2 : 0) | (threshold & 63) << 2;
+}
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join j) { c->execctrl = j; }
+void sm_config_set_clkdiv(pio_sm_config *c, float div) { (void) c; (void) div; }
+void pio_sm_init(PIO pio, uint sm, uint offset, const pio_sm_config *c) {
+  (void) pio; (void) sm; (void) offset;
+  sim_pio_shift_direita = c->shiftctrl & 1;
+  sim_pio_autopull = c->shiftctrl & 2;
+  sim_pio_limiar = c->shiftctrl >> 2;
+  sim_pio_fifo_tx = c->execctrl == PIO_FIFO_JOIN_TX;
+}
+void pio_sm_set_enabled(PIO pio, uint sm, bool en) { (void) pio; (void) sm; (void) en; }
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) { (void) pio; (void) sm; (void) is_tx; return 0; }
+uint32_t clock_get_hz(enum clock_index c) { (void) c; return 125000000; }
+
+// DMA: um canal, concluído pelo teste
+int dma_claim_unused_channel(bool required) { (void) required; return 0; }
+dma_channel_config dma_channel_get_default_config(uint ch) { (void) ch; return (dma_channel_config){ 0 }; }
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size s) {
+  (void) c;
+  sim_matriz_dma_tamanho = s;
+}
+void channel_config_set_read_increment(dma_channel_config *c, bool b) { (void) c; (void) b; }
+void channel_config_set_write_increment(dma_channel_config *c, bool b) { (void) c; (void) b; }
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) { (void) c; (void) dreq; }
+void dma_channel_configure(uint ch, const dma_channel_config *c, volatile void *w, const volatile void *r, uint count, bool trigger) {
+  (void) ch; (void) c; (void) w; (void) r; (void) count; (void) trigger;
+}
+void dma_channel_transfer_from_buffer_now(uint ch, const volatile void *r, uint32_t count) {
+  (void) ch;
+  dma_origem = (const uint32_t *) r;
+  dma_total = count;
+  dma_ocupado = true;
+  sim_matriz_quadros++;
+}
+void dma_channel_set_irq0_enabled(uint ch, bool en) { (void) ch; dma_irq = en; }
+bool dma_channel_get_irq0_status(uint ch) { (void) ch; return dma_irq && !dma_ocupado && dma_origem; }
+void dma_channel_acknowledge_irq0(uint ch) { (void) ch; dma_origem = NULL; }
+void irq_add_shared_handler(uint num, irq_handler_t h, uint8_t prio) { (void) num; (void) prio; tratador_dma = h; }
+void irq_set_enabled(uint num, bool en) { (void) num; (void) en; }
+
+// Relógio: anda 1 us a cada leitura
+uint64_t time_us_64(void) {
+  static uint64_t us;
+  return ++us;
+}
+
+// Alarme e timer: só disparam pelo teste
+int hardware_alarm_claim_unused(bool required) { (void) required; return 0; }
+void hardware_alarm_set_callback(uint alarm_num, hardware_alarm_callback_t callback) { (void) alarm_num; alarme_cb = callback; }
+bool hardware_alarm_set_target(uint alarm_num, absolute_time_t t) {
+  (void) alarm_num; (void) t;
+  alarme_armado = true;
+  return false;
+}
+absolute_time_t make_timeout_time_us(uint64_t us) { return us; }
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out) {
+  out->delay_us = delay_us;
+  out->callback = callback;
+  out->user_data = user_data;
+  timer = out;
+  return true;
+}
+bool cancel_repeating_timer(repeating_timer_t *t) {
+  if (timer == t)
+    timer = NULL;
+  return true;
+}
+
+bool sim_matriz_dma_ocupado(void) { return dma_ocupado; }
+bool sim_matriz_alarme_armado(void) { return alarme_armado; }
+
+void sim_matriz_concluir(void) {
+  if (dma_ocupado) {
+    sim_matriz_palavras = dma_total;
+    memcpy(sim_matriz_fio, dma_origem, dma_total * sizeof(uint32_t));
+    dma_ocupado = false;
+    tratador_dma();
+  }
+  if (alarme_armado) {
+    alarme_armado = false;
+    alarme_cb(0);
+  }
+}
+
+bool sim_matriz_tique(void) {
+  return timer && timer->callback(timer);
+}
+
+// Só as instruções que um programa de LED usa: out (x, com autopull), jmp
+// (sempre ou !x) e mov como nop. Side-set de 1 bit obrigatório (bit 12),
+// atraso nos bits 11-8.
+int sim_ws2812_decodificar(const uint32_t *palavras, uint n, uint8_t *bytes, uint max) {
+  uint pc = 0, lidas = 0, contagem = 32, nbits = 0, alta = 0, ciclos = 0;
+  uint32_t osr = 0, x = 0;
+  for (;;) {
+    uint16_t ins = programa[pc];
+    uint op = ins >> 13, lado = (ins >> 12) & 1, atraso = (ins >> 8) & 0xF;
+    uint proximo = (pc + 1) % programa_tamanho;
+    if (op == 3) { // out x, n
+      uint bits = ins & 31;
+      if (sim_pio_autopull && contagem >= sim_pio_limiar) {
+        if (lidas == n)
+          break; // FIFO vazio: a state machine para com a linha baixa
+        osr = palavras[lidas++];
+        contagem = 0;
+      }
+      if (sim_pio_shift_direita) {
+        x = osr & ((1u << bits) - 1);
+        osr >>= bits;
+      } else {
+        x = osr >> (32 - bits);
+        osr <<= bits;
+      }
+      contagem += bits;
+    } else if (op == 0) { // jmp
+      uint cond = (ins >> 5) & 7;
+      if (cond == 0 || (cond == 1 && !x))
+        proximo = ins & 31;
+    }
+    // Cada ciclo da instrução e do atraso fecha um bit a cada 10
+    for (uint k = 0; k <= atraso; ++k) {
+      alta += lado;
+      if (++ciclos == 10) {
+        if (nbits / 8 >= max)
+          return -1;
+        bytes[nbits / 8] = bytes[nbits / 8] << 1 | (alta > 5);
+        ++nbits;
+        ciclos = alta = 0;
+      }
+    }
+    pc = proximo;
+  }
+  return nbits % 8 || ciclos ? -1 : (int) (nbits / 8);
+}
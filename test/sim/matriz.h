@@ -0,0 +1,44 @@
+#ifndef SIM_MATRIZ_H
+#define SIM_MATRIZ_H
+
+// Bancada da matriz WS2812 no host: PIO, DMA, alarme e timer falsos, que
+// guardam a configuração recebida, e um interpretador do programa PIO
+// carregado que reconstrói os bytes vistos pelos LEDs.
+
+#include "pico/stdlib.h"
+
+// Configuração da state machine recebida por pio_sm_init()
+extern bool sim_pio_shift_direita, sim_pio_autopull;
+extern uint sim_pio_limiar;
+extern bool sim_pio_fifo_tx; // FIFOs juntados para TX
+
+// Tamanho das transferências do canal DMA (DMA_SIZE_*) e quadros iniciados
+extern int sim_matriz_dma_tamanho;
+extern int sim_matriz_quadros;
+
+// Palavras do último quadro que o DMA levou ao FIFO
+extern uint32_t sim_matriz_fio[64];
+extern uint sim_matriz_palavras;
+
+// DMA em andamento ou alarme do reset armado
+bool sim_matriz_dma_ocupado(void);
+bool sim_matriz_alarme_armado(void);
+
+// Termina a transferência (copia as palavras e chama a interrupção do DMA)
+// e depois dispara o alarme do fim do reset
+void sim_matriz_concluir(void);
+
+// Chamado a cada restore_interrupts() (hardware/sync.h com SIM_RELIGAR)
+extern void (*sim_religar)(void);
+
+// Dispara o timer repetitivo, se houver um (pontilhado)
+bool sim_matriz_tique(void);
+
+// Executa o programa carregado por pio_add_program() com a configuração
+// recebida sobre as palavras dadas, até o FIFO esvaziar, e decodifica a
+// linha: um bit a cada 10 ciclos, 1 se ficou mais tempo alta que baixa.
+// Retorna o número de bytes (bits / 8); bits fora de um byte inteiro
+// fazem o retorno ser -1.
+int sim_ws2812_decodificar(const uint32_t *palavras, uint n, uint8_t *bytes, uint max);
+
+#endif
@@ -0,0 +1,224 @@
+#include <stdio.h>
+#include <string.h>
+#include "sim.h"
+
+// SSD1306 emulado: interpreta os bytes de controle (0x00/0x80 comandos,
+// 0x40/0xC0 dados), os comandos de janela e de modo de endereçamento e a
+// rolagem, e grava os dados na GDDRAM seguindo o modo escolhido.
+
+i2c_inst_t i2c0_inst = {0}, i2c1_inst = {1};
+
+uint8_t sim_gddram[2][8][128];
+bool sim_rolando[2];
+long sim_dados_rolando[2];
+uint64_t sim_us;
+long sim_escritas;
+uint sim_ultimo_prazo;
+long sim_nack_em = -1;
+bool sim_travado;
+uint sim_pino_sda = 14, sim_pino_scl = 15;
+bool sim_sda_preso;
+int sim_pulsos_soltar = 3, sim_pulsos;
+
+typedef struct {
+  int modo, col0, col1, pag0, pag1, col, pag;
+  int cmd, esperados, recebidos, args[8];
+} painel_t;
+
+static painel_t paineis[2];
+static bool scl = true;
+
+void sim_reset(void) {
+  memset(sim_gddram, 0, sizeof(sim_gddram));
+  memset(sim_rolando, 0, sizeof(sim_rolando));
+  memset(sim_dados_rolando, 0, sizeof(sim_dados_rolando));
+  for (int b = 0; b < 2; ++b)
+    paineis[b] = (painel_t){ .modo = 2, .col1 = 127, .pag1 = 7, .cmd = -1 };
+  sim_nack_em = -1;
+  sim_travado = false;
+  sim_sda_preso = false;
+  sim_pulsos = 0;
+}
+
+// Bytes de argumento de cada comando
+static int argumentos(int c) {
+  switch (c) {
+  case 0x20: case 0x81: case 0xA8: case 0xD3: case 0xDA:
+  case 0xD5: case 0xD9: case 0xDB: case 0x8D:
+    return 1;
+  case 0x21: case 0x22: case 0xA3:
+    return 2;
+  case 0x29: case 0x2A:
+    return 5;
+  case 0x26: case 0x27:
+    return 6;
+  case 0x2C: case 0x2D:
+    return 7;
+  default:
+    return 0;
+  }
+}
+
+// Rolagem de uma coluna (0x2C/0x2D): o painel move a janela sozinho
+static void rolar_coluna(int b, bool esquerda, int pag0, int pag1, int x0, int x1) {
+  for (int p = pag0; p <= pag1; ++p) {
+    uint8_t *linha = sim_gddram[b][p];
+    if (esquerda) {
+      uint8_t primeira = linha[x0];
+      memmove(&linha[x0], &linha[x0 + 1], x1 - x0);
+      linha[x1] = primeira;
+    } else {
+      uint8_t ultima = linha[x1];
+      memmove(&linha[x0 + 1], &linha[x0], x1 - x0);
+      linha[x0] = ultima;
+    }
+  }
+}
+
+static void comando(int b, uint8_t v) {
+  painel_t *p = &paineis[b];
+  if (p->cmd < 0) {
+    p->cmd = v;
+    p->recebidos = 0;
+    p->esperados = argumentos(v);
+  } else {
+    p->args[p->recebidos++] = v;
+  }
+  if (p->recebidos < p->esperados)
+    return;
+
+  int *a = p->args;
+  switch (p->cmd) {
+  case 0x20:
+    p->modo = a[0];
+    break;
+  case 0x21:
+    p->col0 = p->col = a[0];
+    p->col1 = a[1];
+    break;
+  case 0x22:
+    p->pag0 = p->pag = a[0];
+    p->pag1 = a[1];
+    break;
+  case 0x2C:
+  case 0x2D:
+    rolar_coluna(b, p->cmd == 0x2D, a[1], a[3], a[5], a[6]);
+    break;
+  case 0x2E:
+    sim_rolando[b] = false;
+    break;
+  case 0x2F:
+    sim_rolando[b] = true;
+    break;
+  }
+  p->cmd = -1;
+}
+
+static void dado(int b, uint8_t v) {
+  painel_t *p = &paineis[b];
+  sim_gddram[b][p->pag][p->col] = v;
+  if (sim_rolando[b])
+    ++sim_dados_rolando[b];
+  if (p->modo == 1) {
+    if (++p->pag > p->pag1) {
+      p->pag = p->pag0;
+      if (++p->col > p->col1)
+        p->col = p->col0;
+    }
+  } else if (p->modo == 0) {
+    if (++p->col > p->col1) {
+      p->col = p->col0;
+      if (++p->pag > p->pag1)
+        p->pag = p->pag0;
+    }
+  } else if (++p->col > p->col1) {
+    p->col = p->col0;
+  }
+}
+
+// Uma transação I2C completa (sem o byte de endereço)
+void sim_painel_receber(uint b, const uint8_t *src, size_t len) {
+  size_t i = 0;
+  while (i < len) {
+    uint8_t controle = src[i++];
+    if (controle == 0x00) {
+      while (i < len)
+        comando(b, src[i++]);
+    } else if (controle == 0x80) {
+      if (i < len)
+        comando(b, src[i++]);
+    } else if (controle == 0x40) {
+      while (i < len)
+        dado(b, src[i++]);
+    } else if (controle == 0xC0) {
+      if (i < len)
+        dado(b, src[i++]);
+    } else {
+      printf("byte de controle inválido: %02x\n", controle);
+      return;
+    }
+  }
+}
+
+int sim_diferencas(const ssd1306_t *ssd, uint bus) {
+  int n = 0;
+  for (uint8_t p = 0; p < SSD1306_PAGES(ssd); ++p)
+    for (uint8_t x = 0; x < SSD1306_COLS(ssd); ++x)
+      if (sim_gddram[bus][p][x] != ssd->ram_buffer[ssd1306_index(ssd, x, p)])
+        ++n;
+  return n;
+}
+
+// Barramento a 400 kHz: ~23 us por byte, endereço incluído
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+  (void) addr;
+  (void) nostop;
+  sim_us += (len + 1) * 23;
+  sim_painel_receber(i2c->id, src, len);
+  return (int)len;
+}
+
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop, uint timeout_us) {
+  sim_ultimo_prazo = timeout_us;
+  if (sim_travado || sim_sda_preso) {
+    sim_us += timeout_us;
+    return PICO_ERROR_TIMEOUT;
+  }
+  if (sim_escritas++ == sim_nack_em) {
+    sim_us += 25;
+    return PICO_ERROR_GENERIC;
+  }
+  return i2c_write_blocking(i2c, addr, src, len, nostop);
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+  (void) i2c;
+  return baudrate;
+}
+
+uint64_t time_us_64(void) {
+  return sim_us;
+}
+
+absolute_time_t get_absolute_time(void) {
+  return sim_us;
+}
+
+// GPIO: só SDA e SCL da recuperação têm comportamento; SCL subindo conta
+// um pulso, e SDA solta depois de sim_pulsos_soltar pulsos
+void gpio_init(uint pin) { (void) pin; }
+void gpio_set_function(uint pin, int fn) { (void) pin; (void) fn; }
+void gpio_pull_up(uint pin) { (void) pin; }
+void gpio_set_dir(uint pin, bool out) { (void) pin; (void) out; }
+
+void gpio_put(uint pin, bool value) {
+  if (pin != sim_pino_scl)
+    return;
+  if (!scl && value && ++sim_pulsos >= sim_pulsos_soltar)
+    sim_sda_preso = false;
+  scl = value;
+}
+
+bool gpio_get(uint pin) {
+  return pin == sim_pino_sda ? !sim_sda_preso : true;
+}
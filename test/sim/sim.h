@@ -0,0 +1,54 @@
+#ifndef SIM_H
+#define SIM_H
+
+// Bancada no host: um SSD1306 emulado em cada controlador I2C, escritas com
+// prazo e falhas injetáveis, o controlador I2C com DMA e um GPIO falso para
+// a recuperação do barramento. O tempo só anda com o tráfego simulado.
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "lib/ssd1306.h"
+
+// GDDRAM do painel em cada controlador, na ordem [página][coluna]
+extern uint8_t sim_gddram[2][8][128];
+// Rolagem contínua ligada no painel e bytes de dados recebidos com ela ligada
+extern bool sim_rolando[2];
+extern long sim_dados_rolando[2];
+
+// Tempo simulado (time_us_64) e contadores de escritas síncronas
+extern uint64_t sim_us;
+extern long sim_escritas;
+extern uint sim_ultimo_prazo;
+
+// Falhas: sim_nack_em é o número da escrita que recebe NACK (-1 nenhuma);
+// com sim_travado toda escrita estoura o prazo
+extern long sim_nack_em;
+extern bool sim_travado;
+
+// SDA preso em 0 até o controlador dar sim_pulsos_soltar pulsos em SCL
+// (sim_pulsos conta as subidas de SCL, inclusive a do STOP);
+// enquanto isso as escritas estouram o prazo, como com sim_travado
+extern uint sim_pino_sda, sim_pino_scl;
+extern bool sim_sda_preso;
+extern int sim_pulsos_soltar, sim_pulsos;
+
+// Volta o painel e as falhas ao estado inicial
+void sim_reset(void);
+
+// Entrega ao painel do controlador bus uma transação (sem o endereço)
+void sim_painel_receber(uint bus, const uint8_t *src, size_t len);
+
+// Bytes do framebuffer (na janela toda) diferentes da GDDRAM do painel
+int sim_diferencas(const ssd1306_t *ssd, uint bus);
+
+// DMA: executa a transferência pendente no canal como o barramento a
+// enviaria e gera STOP_DET; ou gera TX_ABRT sem enviar nada
+void sim_i2c_concluir(uint canal, uint bus);
+void sim_i2c_nack(uint canal, uint bus);
+bool sim_dma_ocupado(uint canal);
+i2c_hw_t *sim_i2c_hw(uint bus);
+
+// Palavras de 16 bits (IC_DATA_CMD) da última transferência do canal
+const uint16_t *sim_dma_palavras(uint canal, uint32_t *total);
+
+#endif
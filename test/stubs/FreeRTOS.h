@@ -0,0 +1,15 @@
+#pragma once
+#include <stdint.h>
+typedef long BaseType_t; typedef unsigned long UBaseType_t; typedef uint32_t TickType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xffffffffu
+#define pdMS_TO_TICKS(x) (x)
+#define configMINIMAL_STACK_SIZE 256
+#define configTICK_RATE_HZ 1000
+#define portYIELD_FROM_ISR(x) (void)(x)
+#define portTICK_PERIOD_MS 1
+#define taskENTER_CRITICAL() 
+#define taskEXIT_CRITICAL()
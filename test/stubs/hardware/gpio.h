@@ -0,0 +1,10 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+typedef unsigned int uint;
+#include "pico/stdlib.h"
+enum { GPIO_FUNC_I2C=3, GPIO_FUNC_PWM=4, GPIO_IN=0, GPIO_OUT=1, GPIO_FUNC_SIO=5};
+void gpio_set_function(uint, int); void gpio_pull_up(uint); void gpio_init(uint); void gpio_set_dir(uint,bool); void gpio_put(uint,bool); bool gpio_get(uint);
+enum { GPIO_IRQ_EDGE_FALL=4, GPIO_IRQ_EDGE_RISE=8 };
+typedef void (*gpio_irq_callback_t)(uint, uint32_t);
+void gpio_set_irq_enabled_with_callback(uint, uint32_t, bool, gpio_irq_callback_t); void gpio_set_irq_enabled(uint, uint32_t, bool);
@@ -0,0 +1,27 @@
+#pragma once
+#include "pico/stdlib.h"
+typedef struct i2c_inst i2c_inst_t;
+struct i2c_inst { int id; };
+extern i2c_inst_t i2c0_inst, i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+#define PICO_ERROR_GENERIC -1
+#define PICO_ERROR_TIMEOUT -2
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+typedef struct {
+  volatile uint32_t enable, tar, data_cmd, intr_stat, intr_mask, raw_intr_stat, clr_stop_det, clr_tx_abrt, dma_cr, dma_tdlr, tx_abrt_source, status, txflr, con;
+} i2c_hw_t;
+i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c);
+i2c_inst_t *i2c_get_instance(uint index);
+uint i2c_hw_index(i2c_inst_t *i2c);
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx);
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop, uint timeout_us);
+void i2c_deinit(i2c_inst_t *i2c);
+#define I2C_IC_DATA_CMD_STOP_BITS (1u<<9)
+#define I2C_IC_DATA_CMD_RESTART_BITS (1u<<10)
+#define I2C_IC_INTR_STAT_R_TX_ABRT_BITS (1u<<6)
+#define I2C_IC_INTR_STAT_R_STOP_DET_BITS (1u<<9)
+#define I2C_IC_INTR_MASK_M_TX_ABRT_BITS (1u<<6)
+#define I2C_IC_INTR_MASK_M_STOP_DET_BITS (1u<<9)
+#define I2C_IC_DMA_CR_TDMAE_BITS (1u<<1)
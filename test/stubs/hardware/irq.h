@@ -0,0 +1,8 @@
+#pragma once
+#include "pico/stdlib.h"
+typedef void (*irq_handler_t)(void);
+enum { I2C0_IRQ=23, I2C1_IRQ=24, DMA_IRQ_0=11, DMA_IRQ_1=12, TIMER_IRQ_0=0, TIMER_IRQ_1=1, TIMER_IRQ_2=2, TIMER_IRQ_3=3 };
+void irq_set_exclusive_handler(uint num, irq_handler_t h);
+void irq_add_shared_handler(uint num, irq_handler_t h, uint8_t prio);
+void irq_set_enabled(uint num, bool en);
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
@@ -0,0 +1,27 @@
+#pragma once
+#include "pico/stdlib.h"
+typedef struct { volatile uint32_t txf[4]; volatile uint32_t fstat; } pio_hw_t;
+typedef pio_hw_t *PIO;
+extern pio_hw_t pio0_hw_s, pio1_hw_s;
+#define pio0 (&pio0_hw_s)
+#define pio1 (&pio1_hw_s)
+typedef struct { uint32_t clkdiv, execctrl, shiftctrl, pinctrl; } pio_sm_config;
+struct pio_program { const uint16_t *instructions; uint8_t length; int8_t origin; };
+enum pio_fifo_join { PIO_FIFO_JOIN_NONE=0, PIO_FIFO_JOIN_TX=1, PIO_FIFO_JOIN_RX=2 };
+uint pio_add_program(PIO pio, const struct pio_program *p);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+void pio_gpio_init(PIO pio, uint pin);
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin, uint count, bool out);
+pio_sm_config pio_get_default_sm_config(void);
+void sm_config_set_wrap(pio_sm_config *c, uint t, uint w);
+void sm_config_set_sideset(pio_sm_config *c, uint bits, bool opt, bool pindirs);
+void sm_config_set_sideset_pins(pio_sm_config *c, uint pin);
+void sm_config_set_out_shift(pio_sm_config *c, bool right, bool autopull, uint threshold);
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join j);
+void sm_config_set_clkdiv(pio_sm_config *c, float div);
+void pio_sm_init(PIO pio, uint sm, uint offset, const pio_sm_config *c);
+void pio_sm_set_enabled(PIO pio, uint sm, bool en);
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx);
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm);
+void pio_sm_clear_fifos(PIO pio, uint sm);
@@ -0,0 +1,6 @@
+#pragma once
+#include "pico/stdlib.h"
+typedef struct {uint32_t a;} pwm_config;
+uint pwm_gpio_to_slice_num(uint); uint pwm_gpio_to_channel(uint); pwm_config pwm_get_default_config(void);
+void pwm_config_set_wrap(pwm_config*,uint16_t); void pwm_init(uint,pwm_config*,bool); void pwm_set_gpio_level(uint,uint16_t);
+void pwm_set_clkdiv_int_frac(uint,uint8_t,uint8_t); void pwm_set_wrap(uint,uint16_t); void pwm_set_chan_level(uint,uint,uint16_t); void pwm_set_enabled(uint,bool);
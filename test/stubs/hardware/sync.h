@@ -0,0 +1,15 @@
+#pragma once
+#include "pico/stdlib.h"
+static inline uint32_t save_and_disable_interrupts(void){return 0;}
+#ifdef SIM_RELIGAR
+// Chamado ao religar as interrupções, como uma tarefa que preempta ali
+extern void (*sim_religar)(void);
+static inline void restore_interrupts(uint32_t s){(void)s;if(sim_religar)sim_religar();}
+#else
+static inline void restore_interrupts(uint32_t s){(void)s;}
+#endif
+typedef volatile uint32_t spin_lock_t;
+spin_lock_t *spin_lock_init(uint n); int spin_lock_claim_unused(bool req);
+static inline uint32_t spin_lock_blocking(spin_lock_t *l){(void)l;return 0;}
+static inline void spin_unlock(spin_lock_t *l, uint32_t s){(void)l;(void)s;}
+static inline void __dmb(void){}
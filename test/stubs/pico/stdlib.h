@@ -0,0 +1,22 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+typedef unsigned int uint;
+static inline void sleep_ms(uint32_t ms){(void)ms;}
+static inline void sleep_us(uint64_t us){(void)us;}
+static inline void tight_loop_contents(void){}
+typedef uint64_t absolute_time_t;
+absolute_time_t get_absolute_time(void);
+uint64_t time_us_64(void);
+static inline uint32_t time_us_32(void){return (uint32_t)time_us_64();}
+static inline uint32_t to_ms_since_boot(absolute_time_t t){return (uint32_t)(t/1000);}
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+void stdio_init_all(void);
+#include "hardware/gpio.h"
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+struct repeating_timer { int64_t delay_us; repeating_timer_callback_t callback; void *user_data; };
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out);
+bool cancel_repeating_timer(repeating_timer_t *timer);
@@ -0,0 +1,6 @@
+#pragma once
+#include "FreeRTOS.h"
+typedef void *SemaphoreHandle_t;
+SemaphoreHandle_t xSemaphoreCreateMutex(void); SemaphoreHandle_t xSemaphoreCreateBinary(void); SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t, UBaseType_t);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t); BaseType_t xSemaphoreGive(SemaphoreHandle_t); BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t, BaseType_t*);
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t);
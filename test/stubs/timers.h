@@ -0,0 +1,5 @@
+#pragma once
+#include "FreeRTOS.h"
+typedef void *TimerHandle_t; typedef void (*TimerCallbackFunction_t)(TimerHandle_t);
+TimerHandle_t xTimerCreate(const char*, TickType_t, UBaseType_t, void*, TimerCallbackFunction_t);
+BaseType_t xTimerStart(TimerHandle_t, TickType_t); BaseType_t xTimerStop(TimerHandle_t, TickType_t); void *pvTimerGetTimerID(TimerHandle_t);
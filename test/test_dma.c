@@ -0,0 +1,169 @@
+#include <stdlib.h>
+#include <string.h>
+#include "teste.h"
+#include "sim/sim.h"
+#include "lib/ssd1306_dma.h"
+
+// Montagem da transação do envio por DMA (ssd1306_dma_build) e o caminho
+// de conclusão pela interrupção do I2C. Compilado nos dois layouts do
+// framebuffer; o painel emulado tem de terminar igual ao framebuffer.
+
+static int chamadas;
+static bool ultimo_ok;
+
+static void fim(ssd1306_dma_t *dma, bool ok, void *arg) {
+  (void) dma;
+  ++chamadas;
+  ultimo_ok = ok;
+  *(int *)arg += 1;
+}
+
+// Estrutura: comandos sem RESTART só no início, cada prefixo de dados com
+// RESTART, STOP só na última palavra e a janela de cada sequência de
+// páginas igual à janela suja
+static void checar_palavras(ssd1306_dma_t *dma, const ssd1306_window_t *w, uint8_t paginas) {
+  uint32_t n;
+  const uint16_t *p = sim_dma_palavras(dma->channel, &n);
+  uint8_t vistas = 0;
+  uint32_t i = 0;
+
+  CHECK(n > 0);
+  while (i < n) {
+    CHECK_EQ(p[i] & 0xFF, 0x00);
+    CHECK_EQ(!!(p[i] & I2C_IC_DATA_CMD_RESTART_BITS), i != 0);
+    CHECK_EQ(p[i + 1], SET_COL_ADDR);
+    CHECK_EQ(p[i + 2], w->x0);
+    CHECK_EQ(p[i + 3], w->x1);
+    CHECK_EQ(p[i + 4], SET_PAGE_ADDR);
+    uint8_t p0 = p[i + 5], p1 = p[i + 6];
+    CHECK_EQ(p[i + 7], 0x40 | I2C_IC_DATA_CMD_RESTART_BITS);
+    for (uint8_t q = p0; q <= p1; ++q)
+      vistas |= 1 << q;
+    i += 8 + (w->x1 - w->x0 + 1) * (p1 - p0 + 1);
+  }
+  CHECK_EQ(i, n);
+  CHECK_EQ(vistas, paginas);
+  for (i = 0; i + 1 < n; ++i)
+    CHECK(!(p[i] & I2C_IC_DATA_CMD_STOP_BITS));
+  CHECK(p[n - 1] & I2C_IC_DATA_CMD_STOP_BITS);
+}
+
+static void desenhar_aleatorio(ssd1306_t *ssd) {
+  for (int k = rand() % 4; k >= 0; --k)
+    ssd1306_rect(ssd, rand() % 64, rand() % 128, rand() % 40, rand() % 20, rand() % 2, rand() % 2);
+}
+
+// Páginas que o envio deve levar: as da janela suja que diferem do painel
+// ou cujo hash ainda não representa o painel
+static uint8_t paginas_esperadas(const ssd1306_t *ssd) {
+  uint8_t mascara = 0;
+  for (uint8_t p = ssd->dirty_window.page0; p <= ssd->dirty_window.page1; ++p) {
+    bool difere = !(ssd->hash_valid & (1 << p));
+    for (uint8_t x = 0; x < 128 && !difere; ++x)
+      difere = sim_gddram[1][p][x] != ssd->ram_buffer[ssd1306_index(ssd, x, p)];
+    if (difere)
+      mascara |= 1 << p;
+  }
+  return mascara;
+}
+
+static void teste_aleatorio(ssd1306_t *ssd, ssd1306_dma_t *dma) {
+  srand(3);
+  for (int it = 0; it < 2000; ++it) {
+    desenhar_aleatorio(ssd);
+    ssd1306_window_t w = ssd->dirty_window;
+    uint8_t paginas = ssd->dirty ? paginas_esperadas(ssd) : 0;
+    int antes = chamadas, meu = 0;
+    if (!ssd1306_flush_async(dma, fim, &meu)) {
+      CHECK_EQ(paginas, 0);
+      continue;
+    }
+    CHECK(ssd1306_flush_busy(dma));
+    checar_palavras(dma, &w, paginas);
+    sim_i2c_concluir(dma->channel, 1);
+    CHECK_EQ(chamadas, antes + 1);
+    CHECK_EQ(meu, 1);
+    CHECK(ultimo_ok);
+    CHECK(!ssd1306_flush_busy(dma));
+    if (sim_diferencas(ssd, 1)) {
+      printf("painel difere do framebuffer na iteração %d\n", it);
+      ++teste_falhas;
+      return;
+    }
+  }
+}
+
+// Enquanto um envio está em andamento o seguinte é recusado sem consumir a
+// janela suja; vale também para outro painel no mesmo controlador
+static void teste_ocupado(ssd1306_t *ssd, ssd1306_dma_t *dma) {
+  ssd1306_t outro;
+  ssd1306_dma_t dma_outro;
+  int meu = 0;
+
+  CHECK(ssd1306_init(&outro, 128, 64, false, 0x3D, i2c1));
+  CHECK(ssd1306_dma_init(&dma_outro, &outro));
+
+  ssd1306_fill(ssd, true);
+  CHECK(ssd1306_flush_async(dma, fim, &meu));
+  ssd1306_draw_string(ssd, "A", 0, 0);
+  CHECK(!ssd1306_flush_async(dma, fim, &meu));
+  CHECK(ssd->dirty);
+  ssd1306_fill(&outro, true);
+  CHECK(!ssd1306_flush_async(&dma_outro, NULL, NULL));
+  CHECK(outro.dirty);
+
+  sim_i2c_concluir(dma->channel, 1);
+  CHECK_EQ(meu, 1);
+  CHECK(ssd1306_flush_async(dma, fim, &meu));
+  sim_i2c_concluir(dma->channel, 1);
+  CHECK_EQ(meu, 2);
+  CHECK_EQ(sim_diferencas(ssd, 1), 0);
+  CHECK(ssd1306_flush_async(&dma_outro, NULL, NULL));
+  sim_i2c_concluir(dma_outro.channel, 1);
+}
+
+// NACK durante o envio: o canal e o pedido de DMA param antes de o abort ser
+// limpo, o callback recebe ok = false e o painel fica offline
+static void teste_nack(ssd1306_t *ssd, ssd1306_dma_t *dma) {
+  int meu = 0;
+  uint32_t erros = ssd->i2c_errors;
+
+  ssd1306_fill(ssd, false);
+  CHECK(ssd1306_flush_async(dma, fim, &meu));
+  CHECK(sim_dma_ocupado(dma->channel));
+  CHECK(sim_i2c_hw(1)->dma_cr != 0);
+  sim_i2c_nack(dma->channel, 1);
+  CHECK_EQ(meu, 1);
+  CHECK(!ultimo_ok);
+  CHECK(!ssd1306_flush_busy(dma));
+  CHECK(!sim_dma_ocupado(dma->channel));
+  CHECK_EQ(sim_i2c_hw(1)->dma_cr, 0);
+  CHECK_EQ(sim_i2c_hw(1)->intr_mask, 0);
+  CHECK(!ssd->online);
+  CHECK_EQ(ssd->i2c_errors, erros + 1);
+
+  // Offline nada é enviado; recuperado, o quadro vai inteiro
+  CHECK(!ssd1306_flush_async(dma, fim, &meu));
+  CHECK(ssd1306_recover(ssd));
+  CHECK(ssd1306_flush_async(dma, fim, &meu));
+  sim_i2c_concluir(dma->channel, 1);
+  CHECK(ultimo_ok);
+  CHECK_EQ(sim_diferencas(ssd, 1), 0);
+}
+
+int main(void) {
+  static ssd1306_t ssd;
+  static ssd1306_dma_t dma;
+
+  sim_reset();
+  CHECK(ssd1306_init(&ssd, 128, 64, false, 0x3C, i2c1));
+  ssd1306_set_bus_pins(&ssd, sim_pino_sda, sim_pino_scl);
+  ssd1306_config(&ssd);
+  ssd1306_send_data(&ssd);
+  CHECK(ssd1306_dma_init(&dma, &ssd));
+
+  teste_aleatorio(&ssd, &dma);
+  teste_ocupado(&ssd, &dma);
+  teste_nack(&ssd, &dma);
+  return teste_fim();
+}
@@ -0,0 +1,157 @@
+#include <string.h>
+#include "teste.h"
+#include "sim/sim.h"
+#include "lib/ssd1306_dma.h"
+
+// Falhas de barramento no I2C emulado: NACK no meio de um envio, barramento
+// travado (toda escrita estoura o prazo) e escravo segurando SDA, liberado
+// pelos pulsos de SCL de ssd1306_recover().
+
+static ssd1306_t ssd;
+
+static void preparar(void) {
+  sim_reset();
+  CHECK(ssd1306_init(&ssd, 128, 64, false, 0x3C, i2c1));
+  ssd1306_set_bus_pins(&ssd, sim_pino_sda, sim_pino_scl);
+  ssd1306_config(&ssd);
+  ssd1306_send_data(&ssd);
+}
+
+// Depois do NACK nenhuma outra escrita sai; desenhar e enviar offline não
+// bloqueiam e a recuperação reenvia a tela inteira
+static void teste_nack(void) {
+  preparar();
+  ssd1306_draw_string(&ssd, "Users: 3/8", 0, 0);
+  ssd1306_draw_string(&ssd, "STATUS", 0, 40);
+
+  long inicio = sim_escritas;
+  sim_nack_em = inicio + 2;
+  ssd1306_send_dirty(&ssd);
+  CHECK(!ssd.online);
+  CHECK_EQ(ssd.i2c_errors, 1);
+  CHECK_EQ(sim_escritas, inicio + 3);
+  CHECK(sim_diferencas(&ssd, 1) > 0);
+
+  ssd1306_draw_string(&ssd, "X", 64, 0);
+  long escritas = sim_escritas;
+  uint64_t t = sim_us;
+  ssd1306_send_dirty(&ssd);
+  ssd1306_command(&ssd, SET_DISP | 0x01);
+  CHECK_EQ(sim_escritas, escritas);
+  CHECK_EQ(sim_us, t);
+
+  CHECK(ssd1306_recover(&ssd));
+  CHECK(ssd.online);
+  CHECK_EQ(ssd.i2c_recoveries, 1);
+  CHECK_EQ(sim_pulsos, 1); // SDA livre: só a subida de SCL do STOP
+  ssd1306_send_dirty(&ssd);
+  CHECK_EQ(sim_diferencas(&ssd, 1), 0);
+}
+
+// Barramento travado: o envio bloqueia no máximo o prazo de uma escrita e a
+// recuperação falha até o barramento voltar
+static void teste_travado(void) {
+  preparar();
+  ssd.flush_max_us = 0;
+  ssd1306_fill(&ssd, true);
+
+  sim_travado = true;
+  uint64_t t = sim_us;
+  ssd1306_send_dirty(&ssd);
+  CHECK(!ssd.online);
+  CHECK_EQ(sim_us - t, sim_ultimo_prazo);
+  // A escrita que trava é a primeira, a da janela (0x00 + 6 bytes): com os
+  // valores padrão, 500 + 7 * 30 = 710 us
+  CHECK_EQ(sim_ultimo_prazo, SSD1306_I2C_TIMEOUT_US + 7 * SSD1306_I2C_BYTE_US);
+  CHECK_EQ(ssd.flush_max_us, sim_ultimo_prazo);
+
+  CHECK(!ssd1306_recover(&ssd));
+  CHECK(!ssd.online);
+  CHECK_EQ(ssd.i2c_recoveries, 0);
+
+  sim_travado = false;
+  CHECK(ssd1306_recover(&ssd));
+  ssd1306_send_dirty(&ssd);
+  CHECK_EQ(sim_diferencas(&ssd, 1), 0);
+  CHECK_EQ(ssd.i2c_errors, 2);
+}
+
+// Escravo preso segurando SDA: a recuperação pulsa SCL até SDA soltar (no
+// máximo 9 vezes) e reconfigura o painel
+static void teste_sda_preso(void) {
+  preparar();
+  ssd1306_draw_string(&ssd, "SDA", 0, 16);
+  sim_sda_preso = true;
+  sim_pulsos_soltar = 3;
+  ssd1306_send_dirty(&ssd);
+  CHECK(!ssd.online);
+
+  CHECK(ssd1306_recover(&ssd));
+  CHECK_EQ(sim_pulsos, 3 + 1); // Mais o STOP
+  CHECK(!sim_sda_preso);
+  ssd1306_send_dirty(&ssd);
+  CHECK_EQ(sim_diferencas(&ssd, 1), 0);
+
+  // Preso de vez: 9 pulsos e o painel continua offline
+  preparar();
+  sim_sda_preso = true;
+  sim_pulsos_soltar = 100;
+  ssd1306_fill(&ssd, true);
+  ssd1306_send_dirty(&ssd);
+  CHECK(!ssd1306_recover(&ssd));
+  CHECK_EQ(sim_pulsos, 9 + 1);
+  CHECK(!ssd.online);
+
+  // Sem os pinos informados não há pulsos, só a reconfiguração
+  preparar();
+  ssd.sda_pin = ssd.scl_pin = SSD1306_NO_PIN;
+  sim_sda_preso = true;
+  ssd1306_send_dirty(&ssd);
+  ssd1306_fill(&ssd, true);
+  ssd1306_send_dirty(&ssd);
+  CHECK(!ssd1306_recover(&ssd));
+  CHECK_EQ(sim_pulsos, 0);
+  sim_sda_preso = false;
+  sim_pulsos_soltar = 3;
+}
+
+// Envio por DMA sem STOP_DET nem TX_ABRT (barramento travado): cancelado,
+// conta como falha e não chama o callback
+static int chamadas;
+
+static void fim(ssd1306_dma_t *dma, bool ok, void *arg) {
+  (void) dma;
+  (void) ok;
+  (void) arg;
+  ++chamadas;
+}
+
+static void teste_dma_travado(void) {
+  static ssd1306_dma_t dma;
+
+  preparar();
+  CHECK(ssd1306_dma_init(&dma, &ssd));
+  ssd1306_fill(&ssd, true);
+  CHECK(ssd1306_flush_async(&dma, fim, NULL));
+  ssd1306_flush_abort(&dma);
+  CHECK(!ssd1306_flush_busy(&dma));
+  CHECK(!sim_dma_ocupado(dma.channel));
+  CHECK(!ssd.online);
+  CHECK(!dma.last_ok);
+  CHECK_EQ(chamadas, 0);
+
+  CHECK(!ssd1306_flush_async(&dma, fim, NULL));
+  CHECK(ssd1306_recover(&ssd));
+  CHECK(ssd1306_flush_async(&dma, fim, NULL));
+  sim_i2c_concluir(dma.channel, 1);
+  CHECK_EQ(chamadas, 1);
+  CHECK_EQ(sim_diferencas(&ssd, 1), 0);
+}
+
+int main(void) {
+  teste_nack();
+  teste_travado();
+  teste_sda_preso();
+  teste_dma_travado();
+  return teste_fim();
+}
@@ -0,0 +1,26 @@
+#include <string.h>
+#include "teste.h"
+#include "sim/sim.h"
+
+// ssd1306_init() sem framebuffer disponível: com SSD1306_FIXED_GEOMETRY e
+// SSD1306_STATIC_BUFFERS=1 o segundo painel não tem buffer e a função
+// retorna false sem escrever nada. O primeiro continua utilizável.
+
+int main(void) {
+  static ssd1306_t a, b;
+
+  sim_reset();
+  CHECK(ssd1306_init(&a, 128, 64, false, 0x3C, i2c1));
+  CHECK(a.ram_buffer != NULL);
+  CHECK_EQ(a.ram_buffer[0], 0x40);
+
+  memset(&b, 0xA5, sizeof(b));
+  CHECK(!ssd1306_init(&b, 128, 64, false, 0x3D, i2c0));
+  CHECK(b.ram_buffer == NULL);
+
+  ssd1306_config(&a);
+  ssd1306_draw_string(&a, "OK", 0, 0);
+  ssd1306_send_data(&a);
+  CHECK_EQ(sim_diferencas(&a, 1), 0);
+  return teste_fim();
+}
@@ -0,0 +1,166 @@
+#include <stdlib.h>
+#include "teste.h"
+#include "sim/matriz.h"
+#include "lib/matrixws.h"
+#include "lib/gamma.h"
+#include "hardware/dma.h"
+
+// Matriz WS2812: uma palavra GRB de 24 bits por LED, com autopull de 24
+// bits e deslocamento à esquerda. O programa ws2818b é executado sobre as
+// palavras que o DMA entregou e a linha decodificada deve trazer, LED a
+// LED, G, R e B do bit mais significativo para o menos.
+
+static uint8_t fio[NUM_LEDS * 3];
+
+// Conclui o quadro em envio e decodifica o que saiu na linha
+static int quadro(void) {
+  sim_matriz_concluir();
+  return sim_ws2812_decodificar(sim_matriz_fio, sim_matriz_palavras, fio, sizeof(fio));
+}
+
+// Valor esperado no fio: gama e brilho, arredondados uma vez
+static int esperado(uint8_t v, uint8_t brilho) {
+  return ((uint32_t) gamma16[v] * brilho + 32767) / 65535;
+}
+
+static void teste_configuracao(void) {
+  controle(PINO_MATRIZ);
+  CHECK(!sim_pio_shift_direita);
+  CHECK(sim_pio_autopull);
+  CHECK_EQ(sim_pio_limiar, 24);
+  CHECK(sim_pio_fifo_tx);
+  CHECK_EQ(sim_matriz_dma_tamanho, DMA_SIZE_32);
+
+  // desliga(): 25 palavras, 75 bytes apagados
+  CHECK(matriz_ocupada());
+  CHECK_EQ(quadro(), NUM_LEDS * 3);
+  CHECK_EQ(sim_matriz_palavras, NUM_LEDS);
+  int acesos = 0;
+  for (uint i = 0; i < sizeof(fio); ++i)
+    acesos += fio[i] != 0;
+  CHECK_EQ(acesos, 0);
+  CHECK(!matriz_ocupada());
+  CHECK(g_matriz_monta_max_us > 0); // Medição da montagem atualizada
+}
+
+// Cada componente no seu byte: G, R, B
+static void teste_ordem(void) {
+  set_brilho(BRILHO_MAX);
+  desliga();
+  quadro();
+  cores(0, 255, 0, 0);
+  cores(1, 0, 255, 0);
+  cores(2, 0, 0, 255);
+  cores(24, 255, 255, 255);
+  bf();
+  CHECK_EQ(quadro(), NUM_LEDS * 3);
+  const uint8_t esperados[][3] = { { 0, 255, 0 }, { 255, 0, 0 }, { 0, 0, 255 } };
+  for (uint i = 0; i < 3; ++i)
+    for (uint k = 0; k < 3; ++k)
+      CHECK_EQ(fio[i * 3 + k], esperados[i][k]);
+  for (uint i = 9; i < 72; ++i)
+    CHECK_EQ(fio[i], 0);
+  CHECK_EQ(fio[72], 255);
+  CHECK_EQ(fio[73], 255);
+  CHECK_EQ(fio[74], 255);
+}
+
+// Valores aleatórios em dois brilhos: o fio traz a tabela de gama
+static void teste_valores(void) {
+  const uint8_t brilhos[] = { BRILHO_MAX, BRILHO_PADRAO };
+  srand(22);
+  for (uint b = 0; b < 2; ++b) {
+    set_brilho(brilhos[b]);
+    for (int rodada = 0; rodada < 20; ++rodada) {
+      uint8_t rgb[NUM_LEDS][3];
+      for (uint i = 0; i < NUM_LEDS; ++i) {
+        for (uint k = 0; k < 3; ++k)
+          rgb[i][k] = rand();
+        cores(i, rgb[i][0], rgb[i][1], rgb[i][2]);
+      }
+      bf();
+      CHECK_EQ(quadro(), NUM_LEDS * 3);
+      for (uint i = 0; i < NUM_LEDS; ++i) {
+        CHECK(abs(fio[i * 3 + 0] - esperado(rgb[i][1], brilhos[b])) <= 1);
+        CHECK(abs(fio[i * 3 + 1] - esperado(rgb[i][0], brilhos[b])) <= 1);
+        CHECK(abs(fio[i * 3 + 2] - esperado(rgb[i][2], brilhos[b])) <= 1);
+      }
+    }
+  }
+}
+
+// Linha ocupada: o quadro fica pendente e o mais novo substitui o anterior
+static void teste_pendente(void) {
+  set_brilho(BRILHO_MAX);
+  int inicio = sim_matriz_quadros;
+  cores(0, 10, 0, 0);
+  bf();
+  cores(0, 20, 0, 0);
+  bf();
+  cores(0, 255, 0, 0);
+  bf();
+  CHECK_EQ(sim_matriz_quadros, inicio + 1);
+  CHECK_EQ(quadro(), NUM_LEDS * 3);
+  CHECK_EQ(fio[1], esperado(10, BRILHO_MAX));
+  CHECK_EQ(sim_matriz_quadros, inicio + 2);
+  CHECK_EQ(quadro(), NUM_LEDS * 3);
+  CHECK_EQ(fio[1], 255);
+  CHECK(!matriz_ocupada());
+}
+
+// Pontilhado: em 256 quadros a soma do canal é a fração inteira da tabela
+static void teste_pontilhado(void) {
+  set_brilho(BRILHO_PADRAO);
+  for (uint i = 0; i < NUM_LEDS; ++i)
+    cores(i, 0, 0, 0);
+  cores(0, 100, 0, 0);
+  CHECK(matriz_pontilhado(MATRIZ_PONTILHADO_HZ));
+  CHECK(!matriz_ocupada()); // Os quadros agora vêm só do timer
+  long soma = 0;
+  for (int q = 0; q < 256; ++q) {
+    CHECK(sim_matriz_tique());
+    CHECK_EQ(quadro(), NUM_LEDS * 3);
+    soma += fio[1];
+  }
+  CHECK(labs(soma - ((long) gamma16[100] * BRILHO_PADRAO * 256 + 32767) / 65535) <= 1);
+  // Sem pontilhado o canal volta ao valor arredondado
+  CHECK(matriz_pontilhado(0));
+  CHECK(!sim_matriz_tique());
+  CHECK_EQ(quadro(), NUM_LEDS * 3);
+  CHECK_EQ(fio[1], esperado(100, BRILHO_PADRAO));
+}
+
+// Uma tarefa muda o brilho duas vezes assim que bf() religa as interrupções:
+// a segunda chamada reescreve a tabela que o quadro usou, que tem de estar
+// pronto antes disso, todo no brilho de antes
+static void brilho_duas_vezes(void) {
+  sim_religar = NULL;
+  set_brilho(BRILHO_PADRAO);
+  set_brilho(BRILHO_PADRAO / 2);
+}
+
+static void teste_brilho_concorrente(void) {
+  set_brilho(BRILHO_MAX);
+  for (uint i = 0; i < NUM_LEDS; ++i)
+    cores(i, 200, 200, 200);
+  sim_religar = brilho_duas_vezes;
+  bf();
+  CHECK(sim_religar == NULL);
+  CHECK_EQ(quadro(), NUM_LEDS * 3);
+  for (uint i = 0; i < sizeof(fio); ++i)
+    CHECK_EQ(fio[i], esperado(200, BRILHO_MAX));
+  bf();
+  CHECK_EQ(quadro(), NUM_LEDS * 3);
+  for (uint i = 0; i < sizeof(fio); ++i)
+    CHECK_EQ(fio[i], esperado(200, BRILHO_PADRAO / 2));
+}
+
+int main(void) {
+  teste_configuracao();
+  teste_ordem();
+  teste_valores();
+  teste_pendente();
+  teste_pontilhado();
+  teste_brilho_concorrente();
+  return teste_fim();
+}
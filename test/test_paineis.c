@@ -0,0 +1,84 @@
+#include <stdlib.h>
+#include "teste.h"
+#include "sim/sim.h"
+#include "lib/ssd1306_dma.h"
+#include "lib/display_init.h"
+
+// Com DISPLAY_PAINEIS=2 cada painel sai no seu controlador, os dois envios
+// por DMA correm juntos e não se misturam; dois painéis no mesmo controlador
+// são enviados um de cada vez. Com o padrão (um painel) só o ssd existe.
+
+#if DISPLAY_PAINEIS > 1
+static void desenhar(ssd1306_t *ssd, int semente) {
+  srand(semente);
+  for (int i = 0; i < 4; ++i) {
+    ssd1306_rect(ssd, rand() % 64, rand() % 128, rand() % 60, rand() % 40, rand() & 1, rand() & 1);
+    ssd1306_draw_string(ssd, "Users: 3/8", rand() % 128, rand() % 64);
+  }
+}
+
+static void teste_dois_controladores(void) {
+  CHECK_EQ(display(), 2);
+  ssd1306_t *a = paineis[0], *b = paineis[1];
+  CHECK(a == &ssd);
+  CHECK_EQ(i2c_hw_index(a->i2c_port), 1);
+  CHECK_EQ(i2c_hw_index(b->i2c_port), 0);
+  CHECK_EQ(a->sda_pin, I2C_SDA);
+  CHECK_EQ(b->sda_pin, I2C2_SDA);
+
+  ssd1306_dma_t da, db;
+  CHECK(ssd1306_dma_init(&da, a));
+  CHECK(ssd1306_dma_init(&db, b));
+  for (int k = 0; k < 50; ++k) {
+    desenhar(a, 2 * k);
+    desenhar(b, 2 * k + 1);
+    CHECK(ssd1306_flush_async(&da, NULL, NULL));
+    CHECK(ssd1306_flush_async(&db, NULL, NULL));
+    CHECK(ssd1306_flush_busy(&da) && ssd1306_flush_busy(&db));
+    sim_i2c_concluir(db.channel, 0);
+    sim_i2c_concluir(da.channel, 1);
+    CHECK_EQ(sim_diferencas(a, 1), 0);
+    CHECK_EQ(sim_diferencas(b, 0), 0);
+  }
+  // Quadros diferentes em cada painel: nada foi parar no barramento errado
+  CHECK(sim_diferencas(a, 0) > 0);
+}
+#else
+static void teste_um_painel(void) {
+  CHECK_EQ(display(), 1);
+  CHECK(paineis[0] == &ssd);
+  CHECK_EQ(i2c_hw_index(ssd.i2c_port), 1);
+  CHECK_EQ(sim_diferencas(&ssd, 1), 0);
+}
+#endif
+
+static void teste_mesmo_controlador(void) {
+  ssd1306_t c;
+  ssd1306_dma_t da, dc;
+  CHECK(ssd1306_init(&c, 128, 64, false, 0x3D, i2c1));
+  CHECK(ssd1306_dma_init(&da, &ssd));
+  CHECK(ssd1306_dma_init(&dc, &c));
+  ssd1306_fill(&ssd, true);
+  ssd1306_fill(&c, true);
+
+  CHECK(ssd1306_flush_async(&da, NULL, NULL));
+  CHECK(!ssd1306_flush_async(&dc, NULL, NULL)); // Controlador ocupado
+  CHECK(c.dirty);                               // O quadro continua pendente
+  sim_i2c_concluir(da.channel, 1);
+  CHECK(ssd1306_flush_async(&dc, NULL, NULL));
+  CHECK(sim_i2c_hw(1)->tar == 0x3D);
+  sim_i2c_concluir(dc.channel, 1);
+  CHECK(!ssd1306_flush_busy(&dc));
+  CHECK(dc.last_ok);
+}
+
+int main(void) {
+  sim_reset();
+#if DISPLAY_PAINEIS > 1
+  teste_dois_controladores();
+#else
+  teste_um_painel();
+#endif
+  teste_mesmo_controlador();
+  return teste_fim();
+}
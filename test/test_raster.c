@@ -0,0 +1,156 @@
+#include <stdlib.h>
+#include <string.h>
+#include "teste.h"
+#include "sim/sim.h"
+
+// Imagens de referência das primitivas de raster: cada cena é desenhada e o
+// framebuffer, lido na ordem [página][coluna] para valer nos dois layouts,
+// é comparado com o quadro guardado em golden/raster.h. Depois de uma
+// mudança intencional no desenho, confira as cenas novas e regenere com
+//
+//   build-test/test_raster --gerar > test/golden/raster.h
+
+#define PAGINAS 8
+#define COLUNAS 128
+
+typedef struct {
+  const char *nome;
+  uint8_t quadro[PAGINAS][COLUNAS];
+} golden_t;
+
+#include "golden/raster.h"
+
+// Fundo em xadrez de 1 px: revela bits apagados ou mantidos por engano
+static void fundo(ssd1306_t *ssd) {
+  for (uint8_t p = 0; p < PAGINAS; ++p)
+    for (uint8_t x = 0; x < COLUNAS; ++x)
+      ssd->ram_buffer[ssd1306_index(ssd, x, p)] = x & 1 ? 0xAA : 0x55;
+}
+
+// Bitmap de 12 colunas x 2 páginas com bordas nos bits 0 e 7
+static const uint8_t bitmap[2 * 12] = {
+  0xFF, 0x81, 0x81, 0xBD, 0xA5, 0xA5, 0xA5, 0xA5, 0xBD, 0x81, 0x81, 0xFF,
+  0xFF, 0x01, 0x7D, 0x45, 0x45, 0x7D, 0x01, 0x3C, 0x24, 0x3C, 0x01, 0xFF,
+};
+
+static void cena_fill_area(ssd1306_t *ssd) {
+  fundo(ssd);
+  ssd1306_rect(ssd, 5, 3, 50, 20, true, true);      // Páginas parciais nas bordas
+  ssd1306_rect(ssd, 9, 13, 20, 4, false, true);     // Apaga dentro de uma página
+  ssd1306_rect(ssd, 2, 70, 40, 30, true, false);    // Contorno
+  ssd1306_rect(ssd, 16, 60, 8, 16, false, true);    // Páginas inteiras
+  ssd1306_rect(ssd, 60, 120, 20, 20, true, true);   // Recortado no canto
+  ssd1306_hline(ssd, 0, 127, 63, true);
+  ssd1306_vline(ssd, 127, 0, 63, false);
+  ssd1306_vline(ssd, 56, 7, 8, true);               // Cruza uma divisa de página
+}
+
+static void cena_bitmap_alinhado(ssd1306_t *ssd) {
+  fundo(ssd);
+  ssd1306_draw_bitmap(ssd, bitmap, 10, 8, 12, 2);
+  ssd1306_draw_bitmap(ssd, bitmap, 0, 0, 12, 1);
+  ssd1306_draw_bitmap(ssd, bitmap, 120, 56, 12, 2); // Recorte à direita e embaixo
+}
+
+static void cena_bitmap_desalinhado(ssd1306_t *ssd) {
+  fundo(ssd);
+  ssd1306_draw_bitmap(ssd, bitmap, 10, 13, 12, 2);
+  ssd1306_draw_bitmap(ssd, bitmap, 40, 3, 12, 1);
+  ssd1306_draw_bitmap(ssd, bitmap, 60, 31, 12, 2);
+  ssd1306_draw_bitmap(ssd, bitmap, 121, 59, 12, 2); // Recorte à direita e embaixo
+}
+
+static void cena_char(ssd1306_t *ssd) {
+  fundo(ssd);
+  ssd1306_draw_char(ssd, 'A', 0, 0);
+  ssd1306_draw_char(ssd, 'g', 9, 5);
+  ssd1306_draw_char(ssd, '\x7F', 20, 16);            // Fora da fonte: espaço
+  ssd1306_draw_char(ssd, '~', 123, 60);             // Recortado
+  ssd1306_draw_string(ssd, "Ola, 42!", 30, 27);
+  ssd1306_draw_string(ssd, "fim", 100, 48);
+}
+
+typedef struct {
+  const char *nome;
+  void (*desenhar)(ssd1306_t *ssd);
+} cena_t;
+
+#define CENA(nome) { #nome, cena_##nome }
+
+static const cena_t cenas[] = {
+  CENA(fill_area),
+  CENA(bitmap_alinhado),
+  CENA(bitmap_desalinhado),
+  CENA(char),
+};
+
+#define TOTAL_CENAS (sizeof(cenas) / sizeof(cenas[0]))
+
+static void ler(const ssd1306_t *ssd, uint8_t q[PAGINAS][COLUNAS]) {
+  for (uint8_t p = 0; p < PAGINAS; ++p)
+    for (uint8_t x = 0; x < COLUNAS; ++x)
+      q[p][x] = ssd->ram_buffer[ssd1306_index(ssd, x, p)];
+}
+
+static void gerar(ssd1306_t *ssd) {
+  printf("// Gerado por test_raster --gerar: framebuffer de cada cena de\n");
+  printf("// test_raster.c, na ordem [página][coluna]\n\n");
+  printf("static const golden_t golden[] = {\n");
+  for (size_t c = 0; c < TOTAL_CENAS; ++c) {
+    uint8_t q[PAGINAS][COLUNAS];
+    cenas[c].desenhar(ssd);
+    ler(ssd, q);
+    printf("  { \"%s\", {\n", cenas[c].nome);
+    for (uint8_t p = 0; p < PAGINAS; ++p) {
+      printf("    {\n");
+      for (uint8_t x = 0; x < COLUNAS; ++x)
+        printf("%s0x%02X,%s", x % 16 ? " " : "      ", q[p][x], x % 16 == 15 ? "\n" : "");
+      printf("    },\n");
+    }
+    printf("  } },\n");
+  }
+  printf("};\n");
+}
+
+static const golden_t *procurar(const char *nome) {
+  for (size_t g = 0; g < sizeof(golden) / sizeof(golden[0]); ++g)
+    if (!strcmp(golden[g].nome, nome))
+      return &golden[g];
+  return NULL;
+}
+
+static void conferir(ssd1306_t *ssd, const cena_t *cena) {
+  const golden_t *g = procurar(cena->nome);
+  uint8_t q[PAGINAS][COLUNAS];
+
+  if (!g) {
+    printf("%s: sem quadro de referência em golden/raster.h\n", cena->nome);
+    ++teste_falhas;
+    return;
+  }
+  cena->desenhar(ssd);
+  ler(ssd, q);
+  for (uint8_t p = 0; p < PAGINAS; ++p)
+    for (uint8_t x = 0; x < COLUNAS; ++x)
+      if (q[p][x] != g->quadro[p][x]) {
+        printf("%s: página %u coluna %u: 0x%02X, esperado 0x%02X\n", cena->nome,
+               p, x, q[p][x], g->quadro[p][x]);
+        ++teste_falhas;
+        return;
+      }
+}
+
+int main(int argc, char **argv) {
+  static ssd1306_t ssd;
+
+  sim_reset();
+  CHECK(ssd1306_init(&ssd, 128, 64, false, 0x3C, i2c1));
+  if (argc > 1 && !strcmp(argv[1], "--gerar")) {
+    gerar(&ssd);
+    return 0;
+  }
+
+  for (size_t c = 0; c < TOTAL_CENAS; ++c)
+    conferir(&ssd, &cenas[c]);
+  return teste_fim();
+}
@@ -0,0 +1,114 @@
+#include <string.h>
+#include "teste.h"
+#include "sim/sim.h"
+#include "lib/ssd1306_dma.h"
+#include "lib/ssd1306_widgets.h"
+
+// Aviso rolante: a rolagem contínua do painel não pode estar ligada quando
+// algum dado vai para a GDDRAM, seja qual for a página; o modo coluna a
+// coluna anda um passo por prazo vencido, no ritmo da velocidade dada.
+
+static ssd1306_t ssd;
+static ssd1306_widget_t aviso;
+
+static void preparar(const char *texto) {
+  sim_reset();
+  CHECK(ssd1306_init(&ssd, 128, 64, false, 0x3C, i2c1));
+  ssd1306_config(&ssd);
+  ssd1306_fill(&ssd, false);
+  ssd1306_send_data(&ssd);
+  ssd1306_widget_ticker(&aviso, 0, 56, 128, texto, SSD1306_SCROLL_5_FRAMES);
+  ssd1306_widget_draw(&ssd, &aviso);
+}
+
+// Texto curto: a rolagem fica ligada só enquanto nada mais é enviado
+static void teste_continuo(void) {
+  preparar("Aviso");
+  CHECK_EQ(ssd1306_widget_scroll(&ssd, &aviso, 0), 0);
+  CHECK(sim_rolando[1]);
+  CHECK_EQ(sim_diferencas(&ssd, 1), 0);
+
+  // Nada sujo fora do aviso: a rolagem continua sem comandos novos
+  long escritas = sim_escritas;
+  CHECK_EQ(ssd1306_widget_scroll(&ssd, &aviso, 10), 0);
+  CHECK_EQ(sim_escritas, escritas);
+
+  // Outra página suja: desliga antes do envio e pede nova chamada
+  ssd1306_draw_string(&ssd, "Users: 3/8", 0, 0);
+  CHECK(ssd1306_widget_scroll(&ssd, &aviso, 20) > 0);
+  CHECK(!sim_rolando[1]);
+  ssd1306_send_dirty(&ssd);
+  CHECK_EQ(sim_diferencas(&ssd, 1), 0);
+
+  // Com tudo enviado ela volta
+  CHECK_EQ(ssd1306_widget_scroll(&ssd, &aviso, 80), 0);
+  CHECK(sim_rolando[1]);
+
+  // O mesmo pelo DMA, que envia o quadro depois da chamada
+  ssd1306_dma_t dma;
+  CHECK(ssd1306_dma_init(&dma, &ssd));
+  ssd1306_draw_string(&ssd, "STATUS", 0, 40);
+  CHECK(ssd1306_widget_scroll(&ssd, &aviso, 100) > 0);
+  CHECK(ssd1306_flush_async(&dma, NULL, NULL));
+  sim_i2c_concluir(dma.channel, 1);
+  CHECK(ssd1306_flush_wait(&dma));
+  CHECK_EQ(sim_diferencas(&ssd, 1), 0);
+  CHECK_EQ(ssd1306_widget_scroll(&ssd, &aviso, 160), 0);
+  CHECK(sim_rolando[1]);
+
+  CHECK_EQ(sim_dados_rolando[1], 0);
+}
+
+// Página do aviso no framebuffer, para ver se um passo aconteceu
+static void copiar_aviso(uint8_t *dst) {
+  for (uint8_t x = 0; x < 128; ++x)
+    dst[x] = ssd.ram_buffer[ssd1306_index(&ssd, x, 7)];
+}
+
+static int passos(uint32_t agora, uint32_t *espera) {
+  uint8_t antes[128], depois[128];
+  copiar_aviso(antes);
+  *espera = ssd1306_widget_scroll(&ssd, &aviso, agora);
+  copiar_aviso(depois);
+  ssd1306_send_dirty(&ssd);
+  return memcmp(antes, depois, sizeof(antes)) != 0;
+}
+
+// Texto longo: um passo por prazo, sem passos extras por chamadas a mais
+// nem rajadas para compensar atrasos
+static void teste_passo(void) {
+  preparar("Capacidade máxima atingida: aguarde a saída de um usuário");
+  ssd1306_send_dirty(&ssd);
+  uint32_t espera;
+
+  // 5 quadros de ~11,4 ms
+  CHECK_EQ(passos(1000, &espera), 0);
+  CHECK_EQ(espera, 57);
+  CHECK_EQ(passos(1010, &espera), 0);
+  CHECK_EQ(espera, 47);
+  CHECK_EQ(passos(1057, &espera), 1);
+  CHECK_EQ(espera, 57);
+  CHECK_EQ(passos(1060, &espera), 0);
+  CHECK_EQ(espera, 54);
+  CHECK_EQ(passos(1120, &espera), 1);
+  CHECK_EQ(espera, 51);
+
+  // Atraso de vários passos: um só passo e o ritmo recomeça
+  CHECK_EQ(passos(1500, &espera), 1);
+  CHECK_EQ(espera, 57);
+  CHECK_EQ(passos(1556, &espera), 0);
+
+  // Velocidade mais lenta, prazo mais longo
+  aviso.ticker.speed = SSD1306_SCROLL_25_FRAMES;
+  CHECK_EQ(passos(1557, &espera), 1);
+  CHECK_EQ(espera, 285);
+
+  CHECK_EQ(sim_diferencas(&ssd, 1), 0);
+  CHECK(!sim_rolando[1]);
+}
+
+int main(void) {
+  teste_continuo();
+  teste_passo();
+  return teste_fim();
+}
@@ -0,0 +1,111 @@
+#include <stdlib.h>
+#include <string.h>
+#include "teste.h"
+#include "sim/sim.h"
+#include "lib/ssd1306_tiles.h"
+
+// O renderizador em faixas tem de deixar o painel byte a byte igual ao
+// framebuffer depois dos mesmos itens, na mesma ordem, sobre tela limpa
+// (contrato de ssd1306_tiles.h). Listas aleatórias com itens recortados
+// nas bordas da tela.
+
+#define ITENS 16
+
+static char textos[ITENS][40];
+
+// Acrescenta o mesmo item aleatório à lista e ao framebuffer
+static void item_aleatorio(ssd1306_dl_t *dl, ssd1306_t *ref, int i) {
+  uint8_t x = rand() % 140, y = rand() % 70, w = rand() % 130, h = rand() % 70;
+  bool v = rand() & 1;
+
+  switch (rand() % 5) {
+  case 0: {
+    int n = rand() % 30;
+    for (int j = 0; j < n; ++j)
+      textos[i][j] = ' ' + rand() % 95;
+    textos[i][n] = '\0';
+    x %= 128;
+    y %= 64;
+    CHECK(ssd1306_dl_text(dl, textos[i], x, y));
+    ssd1306_draw_string(ref, textos[i], x, y);
+    break;
+  }
+  case 1:
+    CHECK(ssd1306_dl_rect(dl, y, x, w, h, v, false));
+    ssd1306_rect(ref, y, x, w, h, v, false);
+    break;
+  case 2:
+    CHECK(ssd1306_dl_rect(dl, y, x, w, h, v, true));
+    ssd1306_rect(ref, y, x, w, h, v, true);
+    break;
+  case 3:
+    if (x <= w) {
+      CHECK(ssd1306_dl_hline(dl, x, w, y, v));
+      ssd1306_hline(ref, x, w, y, v);
+    }
+    break;
+  case 4:
+    if (y <= h) {
+      CHECK(ssd1306_dl_vline(dl, x, y, h, v));
+      ssd1306_vline(ref, x, y, h, v);
+    }
+    break;
+  }
+}
+
+// Texto UTF-8: a lista decodifica como ssd1306_draw_string() (um '?' por
+// código fora do ASCII, um por byte inválido), nas posições alinhada,
+// desalinhada e com quebra de linha
+static void teste_acentos(ssd1306_t *ref, ssd1306_t *faixas, ssd1306_dl_t *dl) {
+  static const char *textos_utf8[] = { "STATUS: LOTAÇÃO", "Ação é", "abc\xC3", "né\xE2\x82" };
+  static const uint8_t pos[][2] = { { 0, 0 }, { 3, 5 }, { 90, 20 } };
+
+  for (size_t t = 0; t < sizeof(textos_utf8) / sizeof(textos_utf8[0]); ++t)
+    for (size_t k = 0; k < sizeof(pos) / sizeof(pos[0]); ++k) {
+      ssd1306_dl_clear(dl);
+      ssd1306_fill(ref, false);
+      CHECK(ssd1306_dl_text(dl, textos_utf8[t], pos[k][0], pos[k][1]));
+      ssd1306_draw_string(ref, textos_utf8[t], pos[k][0], pos[k][1]);
+      ssd1306_dl_flush(dl, faixas);
+      int diferentes = sim_diferencas(ref, 1);
+      if (diferentes) {
+        printf("\"%s\" em (%u, %u): %d bytes diferentes\n", textos_utf8[t], pos[k][0], pos[k][1], diferentes);
+        ++teste_falhas;
+      }
+    }
+}
+
+int main(void) {
+  static ssd1306_t ref, faixas;
+  static ssd1306_dl_item_t itens[ITENS];
+  static ssd1306_dl_t dl;
+
+  sim_reset();
+  CHECK(ssd1306_init(&ref, 128, 64, false, 0x3C, i2c1));
+  ssd1306_init_bus(&faixas, 128, 64, false, 0x3C, i2c1);
+  ssd1306_config(&faixas);
+  ssd1306_dl_init(&dl, itens, ITENS);
+
+  srand(9);
+  for (int k = 0; k < 3000; ++k) {
+    ssd1306_dl_clear(&dl);
+    ssd1306_fill(&ref, false);
+    for (int i = rand() % ITENS; i >= 0; --i)
+      item_aleatorio(&dl, &ref, i);
+    ssd1306_dl_flush(&dl, &faixas);
+    if (sim_diferencas(&ref, 1)) {
+      printf("faixas diferem do framebuffer na lista %d: %d bytes\n", k, sim_diferencas(&ref, 1));
+      ++teste_falhas;
+      break;
+    }
+  }
+
+  teste_acentos(&ref, &faixas, &dl);
+
+  // Lista cheia: o item a mais é recusado
+  ssd1306_dl_clear(&dl);
+  for (int i = 0; i < ITENS; ++i)
+    CHECK(ssd1306_dl_hline(&dl, 0, 10, i, true));
+  CHECK(!ssd1306_dl_hline(&dl, 0, 10, 20, true));
+  return teste_fim();
+}
@@ -0,0 +1,52 @@
+#include "teste.h"
+#include "sim/sim.h"
+#include "lib/ssd1306_dma.h"
+
+// Tráfego no barramento, pelos contadores do driver: cada transação conta
+// o byte de endereço, e comandos e dados levam o prefixo 0x00 ou 0x40. Uma
+// regressão no agrupamento de comandos muda estes números.
+
+int main(void) {
+  ssd1306_t ssd;
+  sim_reset();
+  CHECK(ssd1306_init(&ssd, 128, 64, false, 0x3C, i2c1));
+
+  // Sequência de inicialização numa transação: endereço + 0x00 + 26 bytes
+  ssd1306_config(&ssd);
+  CHECK_EQ(ssd.i2c_transactions, 1);
+  CHECK_EQ(ssd.i2c_bytes, 28);
+
+  // Primeiro quadro: janela (endereço + 0x00 + 6) e dados (endereço + 0x40 + 1024)
+  ssd1306_send_data(&ssd);
+  CHECK_EQ(ssd.i2c_transactions, 3);
+  CHECK_EQ(ssd.i2c_bytes, 28 + 8 + 1026);
+
+  // Um dígito de 8x8 numa página: a janela é uma transação de comandos. No
+  // layout por páginas os 8 bytes são contíguos e vão numa só; no vertical
+  // cada coluna é um trecho do buffer e o envio síncrono manda um por vez,
+  // sem cópia (o DMA junta tudo numa transação)
+  ssd1306_draw_char(&ssd, '3', 48, 16);
+  ssd1306_send_dirty(&ssd);
+#ifdef SSD1306_PAGE_MAJOR
+  CHECK_EQ(ssd.i2c_transactions, 3 + 1 + 1);
+  CHECK_EQ(ssd.i2c_bytes, 28 + 8 + 1026 + 8 + (2 + 8));
+#else
+  CHECK_EQ(ssd.i2c_transactions, 3 + 1 + 8);
+  CHECK_EQ(ssd.i2c_bytes, 28 + 8 + 1026 + 8 + 8 * (2 + 1));
+#endif
+  CHECK_EQ(sim_diferencas(&ssd, 1), 0);
+
+  // Pelo DMA, em qualquer layout: comandos e dados com RESTART entre eles
+  ssd1306_dma_t dma;
+  CHECK(ssd1306_dma_init(&dma, &ssd));
+  uint32_t transacoes = ssd.i2c_transactions, bytes = ssd.i2c_bytes;
+  ssd1306_draw_char(&ssd, '7', 48, 16);
+  CHECK(ssd1306_flush_async(&dma, NULL, NULL));
+  sim_i2c_concluir(dma.channel, 1);
+  CHECK(ssd1306_flush_wait(&dma));
+  CHECK_EQ(ssd.i2c_transactions - transacoes, 2);
+  CHECK_EQ(ssd.i2c_bytes - bytes, 8 + (2 + 8));
+  CHECK_EQ(sim_diferencas(&ssd, 1), 0);
+
+  return teste_fim();
+}
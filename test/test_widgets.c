@@ -0,0 +1,159 @@
+#include <stdlib.h>
+#include <string.h>
+#include "teste.h"
+#include "sim/sim.h"
+#include "lib/ssd1306_widgets.h"
+#include "lib/ssd1306_text.h"
+
+// Os setters escrevem no membro da união do tipo do widget; nos outros
+// tipos os mesmos bytes são ponteiros e estado que não podem mudar
+
+static void teste_grafico(void) {
+  uint8_t amostras[32] = { 0 };
+  ssd1306_widget_t g;
+  ssd1306_widget_graph(&g, 0, 0, 32, 16, amostras, 32, 8);
+  ssd1306_widget_push(&g, 5);
+  g.invalid = false;
+
+  CHECK(ssd1306_widget_set_max(&g, 10));
+  CHECK_EQ(g.graph.max, 10);
+  CHECK(g.invalid);
+  CHECK(!ssd1306_widget_set_max(&g, 10));
+
+  g.invalid = false;
+  CHECK(!ssd1306_widget_set_value(&g, 7));
+  CHECK(!g.invalid);
+  CHECK_EQ(g.graph.value, 5);
+  CHECK(g.graph.samples == amostras);
+  CHECK_EQ(g.graph.count, 1);
+
+  // Texto e bitmap cairiam sobre value/max e o ponteiro das amostras
+  static const uint8_t icone[8] = { 0xFF };
+  CHECK(!ssd1306_widget_set_text(&g, "X"));
+  CHECK(!ssd1306_widget_set_bitmap(&g, icone));
+  CHECK(!g.invalid);
+  CHECK_EQ(g.graph.value, 5);
+  CHECK_EQ(g.graph.max, 10);
+  CHECK(g.graph.samples == amostras);
+}
+
+static void teste_texto_bitmap(void) {
+  static const uint8_t icone[8] = { 0xFF };
+  ssd1306_widget_t l, t, i, b;
+  ssd1306_widget_label(&l, 0, 0, 64, "A");
+  ssd1306_widget_ticker(&t, 0, 56, 128, "A", SSD1306_SCROLL_5_FRAMES);
+  ssd1306_widget_icon(&i, 0, 0, 8, 8, NULL);
+  ssd1306_widget_bar(&b, 0, 0, 64, 8, 3, 8);
+
+  CHECK(ssd1306_widget_set_text(&l, "B"));
+  CHECK(l.text[0] == 'B');
+  CHECK(ssd1306_widget_set_text(&t, "C"));
+  CHECK(t.ticker.text[0] == 'C');
+  CHECK(ssd1306_widget_set_bitmap(&i, icone));
+  CHECK(i.bitmap == icone);
+
+  CHECK(!ssd1306_widget_set_bitmap(&l, icone));
+  CHECK(l.text[0] == 'B');
+  CHECK(!ssd1306_widget_set_text(&i, "D"));
+  CHECK(i.bitmap == icone);
+  CHECK(!ssd1306_widget_set_text(&b, "E"));
+  CHECK(!ssd1306_widget_set_bitmap(&b, icone));
+  CHECK_EQ(b.bar.value, 3);
+  CHECK_EQ(b.bar.max, 8);
+}
+
+static void teste_outros(void) {
+  ssd1306_widget_t l;
+  ssd1306_widget_label(&l, 0, 0, 64, "Texto");
+  l.invalid = false;
+  CHECK(!ssd1306_widget_set_value(&l, 1));
+  CHECK(!ssd1306_widget_set_max(&l, 1));
+  CHECK(l.text != NULL && l.text[0] == 'T');
+  CHECK(!l.invalid);
+
+  ssd1306_widget_t b;
+  ssd1306_widget_bar(&b, 0, 0, 64, 8, 1, 8);
+  CHECK(ssd1306_widget_set_value(&b, 3));
+  CHECK(ssd1306_widget_set_max(&b, 4));
+  CHECK_EQ(b.bar.value, 3);
+  CHECK_EQ(b.bar.max, 4);
+
+  ssd1306_widget_t n;
+  ssd1306_widget_number(&n, 0, 0, 64, 1, 0);
+  CHECK(ssd1306_widget_set_value(&n, 42));
+  CHECK_EQ(n.number.value, 42);
+  CHECK(!ssd1306_widget_set_max(&n, 9));
+  CHECK_EQ(n.number.decimals, 0);
+}
+
+// A escala mudaria value/max da barra, o gráfico e a altura da caixa
+static void teste_escala(void) {
+  ssd1306_widget_t n;
+  ssd1306_widget_number(&n, 0, 0, 64, 7, 0);
+  CHECK(ssd1306_widget_set_scale(&n, 2));
+  CHECK_EQ(n.number.scale, 2);
+  CHECK_EQ(n.h, 16);
+  CHECK_EQ(n.number.value, 7);
+  CHECK(!ssd1306_widget_set_scale(&n, 2));
+  CHECK(!ssd1306_widget_set_scale(&n, SSD1306_BIG_MAX + 1));
+
+  ssd1306_widget_t b;
+  ssd1306_widget_bar(&b, 0, 0, 64, 8, 3, 8);
+  b.invalid = false;
+  CHECK(!ssd1306_widget_set_scale(&b, 3));
+  CHECK_EQ(b.h, 8);
+  CHECK_EQ(b.bar.value, 3);
+  CHECK_EQ(b.bar.max, 8);
+  CHECK(!b.invalid);
+
+  uint8_t amostras[16] = { 0 };
+  ssd1306_widget_t g;
+  ssd1306_widget_graph(&g, 0, 0, 16, 16, amostras, 16, 8);
+  CHECK(!ssd1306_widget_set_scale(&g, 4));
+  CHECK_EQ(g.h, 16);
+  CHECK(g.graph.samples == amostras);
+  CHECK_EQ(g.graph.size, 16);
+}
+
+// Gráfico: k < w amostras novas andam por um deslocamento só e o resultado
+// é o mesmo do gráfico redesenhado inteiro, nos dois layouts e com a caixa
+// na altura toda ou em parte das páginas
+static void teste_grafico_deslocado(void) {
+  static const struct { uint8_t x, y, w, h; } caixas[] = {
+    { 0, 16, 128, 16 }, { 20, 8, 40, 24 }, { 0, 0, 128, 64 }, { 7, 0, 100, 64 },
+  };
+  ssd1306_t ssd;
+  CHECK(ssd1306_init(&ssd, 128, 64, false, 0x3C, i2c1));
+  uint8_t *antes = malloc(ssd.bufsize);
+  srand(19);
+  for (uint c = 0; c < sizeof(caixas) / sizeof(caixas[0]); ++c) {
+    uint8_t amostras[128];
+    ssd1306_widget_t g;
+    ssd1306_widget_graph(&g, caixas[c].x, caixas[c].y, caixas[c].w, caixas[c].h, amostras, caixas[c].w, 20);
+    ssd1306_fill(&ssd, false);
+    for (int n = 0; n < caixas[c].w; ++n)
+      ssd1306_widget_push(&g, rand() % 24);
+    ssd1306_widget_draw(&ssd, &g);
+
+    for (int rodada = 0; rodada < 50; ++rodada) {
+      int k = 1 + rand() % (caixas[c].w - 1);
+      for (int n = 0; n < k; ++n)
+        ssd1306_widget_push(&g, rand() % 24);
+      ssd1306_widget_draw(&ssd, &g);
+      memcpy(antes, ssd.ram_buffer, ssd.bufsize);
+      ssd1306_widget_invalidate(&g);
+      ssd1306_widget_draw(&ssd, &g);
+      CHECK(memcmp(antes, ssd.ram_buffer, ssd.bufsize) == 0);
+    }
+  }
+  free(antes);
+}
+
+int main(void) {
+  teste_grafico();
+  teste_outros();
+  teste_texto_bitmap();
+  teste_escala();
+  teste_grafico_deslocado();
+  return teste_fim();
+}
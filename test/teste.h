@@ -0,0 +1,36 @@
+#ifndef TESTE_H
+#define TESTE_H
+
+#include <stdio.h>
+
+// Verificação mínima para os testes no host: cada falha é impressa com o
+// local e contada; o main termina com return teste_fim().
+static int teste_falhas;
+
+#define CHECK(cond)                                                   \
+  do {                                                                \
+    if (!(cond)) {                                                    \
+      printf("%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond);       \
+      ++teste_falhas;                                                 \
+    }                                                                 \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                \
+  do {                                                                \
+    long long _a = (a), _b = (b);                                     \
+    if (_a != _b) {                                                   \
+      printf("%s:%d: falhou: %s == %s (%lld != %lld)\n", __FILE__,    \
+             __LINE__, #a, #b, _a, _b);                               \
+      ++teste_falhas;                                                 \
+    }                                                                 \
+  } while (0)
+
+static inline int teste_fim(void) {
+  if (teste_falhas)
+    printf("%d falha(s)\n", teste_falhas);
+  else
+    printf("ok\n");
+  return teste_falhas != 0;
+}
+
+#endif
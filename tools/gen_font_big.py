@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+# Gera lib/font_big.h a partir de lib/font.h: os glifos de '-' a '9' são
+# ampliados 2x, 3x e 4x e gravados já no formato de página do SSD1306, para
+# que o desenho em escala seja só uma cópia de bytes.
+#
+# Uso: python3 tools/gen_font_big.py > lib/font_big.h
+
+import re
+import sys
+from pathlib import Path
+
+PRIMEIRO, ULTIMO = '-', '9'
+ESCALAS = (2, 3, 4)
+
+def ler_fonte(caminho):
+    texto = caminho.read_text(encoding='utf-8')
+    corpo = texto[texto.index('{') + 1:texto.index('}')]
+    return [int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]{2}', corpo)]
+
+def ampliar(colunas, k):
+    # Cada bit vira k bits e cada coluna vira k colunas; saída em
+    # bitmap[p * w + i] (página p, coluna i), como ssd1306_draw_bitmap()
+    w = 8 * k
+    saida = [0] * (w * k)
+    for i, byte in enumerate(colunas):
+        bits = 0
+        for j in range(8):
+            if byte & (1 << j):
+                bits |= ((1 << k) - 1) << (j * k)
+        for p in range(k):
+            valor = (bits >> (8 * p)) & 0xFF
+            for r in range(k):
+                saida[p * w + i * k + r] = valor
+    return saida
+
+def main():
+    raiz = Path(__file__).resolve().parent.parent
+    fonte = ler_fonte(raiz / 'lib' / 'font.h')
+    chars = [chr(c) for c in range(ord(PRIMEIRO), ord(ULTIMO) + 1)]
+
+    out = sys.stdout
+    out.write('#ifndef FONT_BIG_H\n#define FONT_BIG_H\n\n')
+    out.write('// Gerado por tools/gen_font_big.py a partir de font.h; não edite.\n')
+    out.write('// Glifos de \'%s\' a \'%s\' ampliados, no formato de ssd1306_draw_bitmap():\n' % (PRIMEIRO, ULTIMO))
+    out.write('// font_bigK[c - FONT_BIG_FIRST][p * 8K + i] é a coluna i da página p.\n\n')
+    out.write('#include <stdint.h>\n\n')
+    out.write("#define FONT_BIG_FIRST '%s'\n#define FONT_BIG_LAST '%s'\n\n" % (PRIMEIRO, ULTIMO))
+    for k in ESCALAS:
+        tam = 8 * k * k
+        out.write('static const uint8_t font_big%d[%d][%d] = {\n' % (k, len(chars), tam))
+        for c in chars:
+            base = (ord(c) - ord(' ')) * 8
+            dados = ampliar(fonte[base:base + 8], k)
+            out.write('  { // %s\n' % c)
+            for p in range(k):
+                linha = dados[p * 8 * k:(p + 1) * 8 * k]
+                out.write('    ' + ', '.join('0x%02X' % v for v in linha) + ',\n')
+            out.write('  },\n')
+        out.write('};\n\n')
+    out.write('#endif\n')
+
+if __name__ == '__main__':
+    main()
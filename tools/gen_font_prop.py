@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+# Gera lib/font_prop.c a partir de lib/font.h: fonte proporcional com as
+# colunas vazias de cada glifo removidas, mais as letras acentuadas do
+# português (Latin-1) compostas a partir da letra base e de um acento.
+#
+# Uso: python3 tools/gen_font_prop.py > lib/font_prop.c
+
+import re
+import sys
+from pathlib import Path
+
+LARGURA_ESPACO = 2
+
+# Acentos em duas linhas (bits 0 e 1), uma entrada por coluna
+ACENTOS = {
+    'agudo': [0x02, 0x01],
+    'grave': [0x01, 0x02],
+    'circ': [0x02, 0x01, 0x02],
+    'til': [0x02, 0x01, 0x02, 0x01],
+    'trema': [0x01, 0x00, 0x01],
+}
+
+COMPOSTOS = {
+    'À': ('A', 'grave'), 'Á': ('A', 'agudo'), 'Â': ('A', 'circ'), 'Ã': ('A', 'til'),
+    'Ç': ('C', 'cedilha'), 'É': ('E', 'agudo'), 'Ê': ('E', 'circ'), 'Í': ('I', 'agudo'),
+    'Ó': ('O', 'agudo'), 'Ô': ('O', 'circ'), 'Õ': ('O', 'til'), 'Ú': ('U', 'agudo'),
+    'Ü': ('U', 'trema'),
+    'à': ('a', 'grave'), 'á': ('a', 'agudo'), 'â': ('a', 'circ'), 'ã': ('a', 'til'),
+    'ç': ('c', 'cedilha'), 'é': ('e', 'agudo'), 'ê': ('e', 'circ'), 'í': ('i', 'agudo'),
+    'ó': ('o', 'agudo'), 'ô': ('o', 'circ'), 'õ': ('o', 'til'), 'ú': ('u', 'agudo'),
+    'ü': ('u', 'trema'),
+}
+
+# Glifos desenhados à mão (colunas já recortadas)
+EXTRAS = {
+    '°': [0x06, 0x09, 0x09, 0x06],
+    'ª': [0x12, 0x15, 0x15, 0x1E],
+    'º': [0x12, 0x15, 0x15, 0x12],
+}
+
+def ler_fonte(caminho):
+    texto = caminho.read_text(encoding='utf-8')
+    corpo = texto[texto.index('{') + 1:texto.index('}')]
+    return [int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]{2}', corpo)]
+
+def recortar(colunas):
+    usadas = [i for i, c in enumerate(colunas) if c]
+    if not usadas:
+        return [0] * LARGURA_ESPACO
+    return colunas[usadas[0]:usadas[-1] + 1]
+
+def bit(v, n):
+    return (v >> n) & 1
+
+# Maiúsculas ocupam as linhas 0-6; para abrir espaço ao acento, as 7
+# linhas viram 5 (juntando 1+2 e 4+5) nas linhas 2-6
+def comprimir(c):
+    linhas = [bit(c, 0), bit(c, 1) | bit(c, 2), bit(c, 3), bit(c, 4) | bit(c, 5), bit(c, 6)]
+    saida = c & 0x80
+    for i, b in enumerate(linhas):
+        saida |= b << (i + 2)
+    return saida
+
+def compor(base, acento):
+    colunas = list(base)
+    if acento == 'cedilha':
+        meio = len(colunas) // 2
+        colunas[meio - 1] |= 0x80
+        colunas[meio] |= 0x80
+        return colunas
+    marca = ACENTOS[acento]
+    inicio = (len(colunas) - len(marca)) // 2
+    for i, m in enumerate(marca):
+        colunas[inicio + i] |= m
+    return colunas
+
+def glifo_base(fonte, ch):
+    base = (ord(ch) - ord(' ')) * 8
+    return recortar(fonte[base:base + 8])
+
+def glifos(fonte):
+    tabela = {}
+    for code in range(0x20, 0x7F):
+        tabela[code] = glifo_base(fonte, chr(code))
+    for ch, (letra, acento) in COMPOSTOS.items():
+        base = glifo_base(fonte, letra)
+        if acento != 'cedilha':
+            if letra.isupper():
+                base = [comprimir(c) for c in base]
+            else:
+                base = [c & 0xFC for c in base]  # 'i' sem o pingo
+        tabela[ord(ch)] = compor(base, acento)
+    for ch, colunas in EXTRAS.items():
+        tabela[ord(ch)] = colunas
+    return tabela
+
+# Os códigos são agrupados em blocos de 32 (SSD1306_FONT_BLOCK_BITS); só os
+# blocos com algum glifo entram na tabela, com os buracos como glifos de
+# largura zero. A busca é um acesso à tabela de blocos e outro aos glifos.
+BLOCO_BITS = 5
+BLOCO = 1 << BLOCO_BITS
+SEM_BLOCO = 0xFFFF
+
+# Caixa vazia desenhada para códigos sem glifo
+SUBSTITUTO = [0x7E, 0x42, 0x42, 0x42, 0x7E]
+
+def main():
+    raiz = Path(__file__).resolve().parent.parent
+    tabela = glifos(ler_fonte(raiz / 'lib' / 'font.h'))
+    total = (max(tabela) >> BLOCO_BITS) + 1
+
+    blocos, bitmap, indice = [], [], []
+    for b in range(total):
+        codigos = range(b * BLOCO, (b + 1) * BLOCO)
+        if not any(c in tabela for c in codigos):
+            blocos.append(SEM_BLOCO)
+            continue
+        blocos.append(len(indice))
+        for c in codigos:
+            colunas = tabela.get(c, [])
+            indice.append((len(bitmap), len(colunas), c))
+            bitmap.extend(colunas)
+    substituto = len(indice)
+    indice.append((len(bitmap), len(SUBSTITUTO), None))
+    bitmap.extend(SUBSTITUTO)
+
+    out = sys.stdout
+    out.write('// Gerado por tools/gen_font_prop.py a partir de font.h; não edite.\n')
+    out.write('// Fonte proporcional de 8 linhas: ASCII e letras acentuadas do português.\n\n')
+    out.write('#include "lib/ssd1306_font.h"\n\n')
+    out.write('static const uint8_t font_prop_bitmap[%d] = {\n' % len(bitmap))
+    for offset, largura, c in indice:
+        if not largura:
+            continue
+        colunas = bitmap[offset:offset + largura]
+        if c is None:
+            nome = 'substituto'
+        else:
+            nome = chr(c) if c != 0x5C else 'barra invertida'
+        out.write('  ' + ', '.join('0x%02X' % v for v in colunas) + ', // %s\n' % nome)
+    out.write('};\n\n')
+    out.write('static const ssd1306_glyph_t font_prop_glyphs[%d] = {\n' % len(indice))
+    for offset, largura, c in indice:
+        nome = 'substituto' if c is None else 'U+%04X' % c
+        out.write('  { %4d, %d }, // %s\n' % (offset, largura, nome))
+    out.write('};\n\n')
+    out.write('static const uint16_t font_prop_blocks[%d] = {\n' % len(blocos))
+    for b, base in enumerate(blocos):
+        valor = 'SSD1306_FONT_NO_BLOCK' if base == SEM_BLOCO else '%d' % base
+        out.write('  %s, // U+%04X\n' % (valor, b * BLOCO))
+    out.write('};\n\n')
+    out.write('const ssd1306_font_t ssd1306_font_prop = {\n')
+    out.write('  font_prop_bitmap,\n  font_prop_glyphs,\n  font_prop_blocks,\n')
+    out.write('  %d,   // Blocos\n  %d, // Glifo substituto\n  1,   // Colunas entre glifos\n};\n' % (len(blocos), substituto))
+
+if __name__ == '__main__':
+    main()
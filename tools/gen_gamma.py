@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+# Gera lib/gamma.h: curva de gama da matriz WS2812 com 16 bits de
+# resolução. matrixws.c combina a curva com o brilho global numa tabela de
+# 256 entradas, refeita só quando o brilho muda.
+#
+# Uso: python3 tools/gen_gamma.py > lib/gamma.h
+
+import sys
+
+GAMA = 2.2
+
+def main():
+    valores = [round(((i / 255) ** GAMA) * 65535) for i in range(256)]
+
+    out = sys.stdout
+    out.write('#ifndef GAMMA_H\n#define GAMMA_H\n\n')
+    out.write('// Gerado por tools/gen_gamma.py; não edite.\n')
+    out.write('// gamma16[i] = (i / 255)^%.1f em 0..65535.\n\n' % GAMA)
+    out.write('#include <stdint.h>\n\n')
+    out.write('static const uint16_t gamma16[256] = {\n')
+    for i in range(0, 256, 16):
+        out.write('  ' + ', '.join('%5d' % v for v in valores[i:i + 16]) + ',\n')
+    out.write('};\n\n')
+    out.write('#endif\n')
+
+if __name__ == '__main__':
+    main()